@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+Minimal self-contained benchmark harness.
+
+Every benchmark runs `run` repeatedly: first for a warmup period, then for a number of samples. Each sample
+times a batch of runs long enough to be measured reliably, and the reported time is the time of a single run.
+`setup` (optional) runs untimed before every sample.
+*/
+struct Benchmark
+{
+    std::string name;
+    // What a single item processed by `run` is, e.g. "moves"
+    std::string unit;
+    // Number of items processed by one call of `run`
+    double itemsPerRun = 1.0;
+    std::function<void()> setup;
+    std::function<void()> run;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    std::string unit;
+    double itemsPerRun;
+    unsigned long long runsPerSample;
+    // Nanoseconds per run
+    double min, mean, p50, p90, p99, max;
+    // Items per second at the median
+    double throughput;
+};
+
+// All benchmarks registered with BENCHMARK_REGISTER
+std::vector<Benchmark>& GetBenchmarks();
+
+struct BenchmarkRegistrar
+{
+    BenchmarkRegistrar(const Benchmark& benchmark) { GetBenchmarks().push_back(benchmark); }
+};
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+// Register a benchmark from a brace initializer: BENCHMARK_REGISTER({ "name", "unit", items, setup, run });
+#define BENCHMARK_REGISTER(...) static BenchmarkRegistrar BENCHMARK_CONCAT(s_Benchmark, __LINE__)(Benchmark __VA_ARGS__)
+
+// Keep the compiler from optimizing away a value that is otherwise unused
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
@@ -0,0 +1,90 @@
+#include "Bench.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <RubiksCube.h>
+#include <TransformBatch.h>
+
+#include <random>
+
+// Hot paths of the cube itself: applying moves and preparing a frame
+
+static const int MOVES_PER_RUN = 100;
+static const int SCRAMBLE_LENGTH = 25;
+
+// Fixed pseudo-random face sequence so that every run measures the same work
+static std::vector<int> makeFaceSequence(int length, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> face(0, 5);
+    std::vector<int> faces(length);
+    for(int& f : faces) {
+        f = face(rng);
+    }
+    return faces;
+}
+
+static const std::vector<int> s_Moves = makeFaceSequence(MOVES_PER_RUN, 1);
+static const std::vector<int> s_Scramble = makeFaceSequence(SCRAMBLE_LENGTH, 2);
+
+BENCHMARK_REGISTER({ "cube/rotateFace", "moves", MOVES_PER_RUN,
+    []() { RubiksCube::getInstance().reset(); },
+    []() {
+        RubiksCube& cube = RubiksCube::getInstance();
+        for(int face : s_Moves) {
+            cube.rotateFace(face);
+        }
+        DoNotOptimize(cube.getCubes()[0]);
+    }
+});
+
+BENCHMARK_REGISTER({ "cube/rotateCube", "moves", 4,
+    []() { RubiksCube::getInstance().reset(); },
+    []() {
+        RubiksCube& cube = RubiksCube::getInstance();
+        cube.rotateCube(CUBE_X_AXIS);
+        cube.rotateCube(CUBE_Y_AXIS);
+        cube.rotateCube(-CUBE_X_AXIS);
+        cube.rotateCube(-CUBE_Y_AXIS);
+        DoNotOptimize(cube.getCubes()[0]);
+    }
+});
+
+BENCHMARK_REGISTER({ "cube/scramble25", "scrambles", 1,
+    nullptr,
+    []() {
+        RubiksCube& cube = RubiksCube::getInstance();
+        cube.reset();
+        for(int face : s_Scramble) {
+            cube.rotateFace(face);
+        }
+        DoNotOptimize(cube.getCubes()[0]);
+    }
+});
+
+BENCHMARK_REGISTER({ "cube/stateHash", "hashes", 1,
+    []() {
+        RubiksCube& cube = RubiksCube::getInstance();
+        cube.reset();
+        for(int face : s_Scramble) {
+            cube.rotateFace(face);
+        }
+    },
+    []() { DoNotOptimize(RubiksCube::getInstance().getStateHash()); }
+});
+
+// Per-frame transform preparation of main.cpp, 27 MVP matrices
+static const glm::mat4 s_ViewProjection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f)
+    * glm::lookAt(glm::vec3(0.0f, 0.0f, 8.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+static glm::mat4 s_Mvps[27];
+
+BENCHMARK_REGISTER({ "frame/transforms", "frames", 1,
+    nullptr,
+    []() {
+        static TransformBatch transforms;
+        transforms.load(RubiksCube::getInstance().getCubes(), 27);
+        transforms.compute(s_ViewProjection, nullptr, s_Mvps);
+        DoNotOptimize(s_Mvps[26]);
+    }
+});
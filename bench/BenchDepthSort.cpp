@@ -0,0 +1,61 @@
+#include "Bench.h"
+
+#include <DepthSort.h>
+#include <Random.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Back-to-front order of the cubies for blending without order-independent transparency, sorted every frame
+
+struct SortScene
+{
+    std::vector<glm::mat4> models;
+    glm::mat4 view;
+    DepthSort sort;
+};
+
+// Depths along the order must never increase
+static void checkOrder(SortScene& scene)
+{
+    const std::vector<uint32_t>& order = scene.sort.sort(scene.models.data(), scene.models.size(), scene.view);
+    float previous = 1e30f;
+    for(uint32_t index : order) {
+        float depth = -(scene.view * scene.models[index][3]).z;
+        // Keys keep 13 bits of mantissa, depths within a relative 2^-13 may come in any order
+        if(depth > previous + std::abs(previous) * 2e-4f) {
+            fprintf(stderr, "depth sort: cubie %u is behind the previous one\n", index);
+            exit(1);
+        }
+        previous = std::min(previous, depth);
+    }
+}
+
+static int registerDepthSortBenchmarks()
+{
+    for(int count : { 1000, 10000, 100000 }) {
+        SortScene* scene = new SortScene();
+        Xoshiro256 random(count);
+        auto uniform = [&random]() { return (float)(random.next() >> 40) * (1.0f / 16777216.0f); };
+        for(int i = 0; i < count; i++) {
+            glm::vec3 position(uniform() * 200.0f - 100.0f, uniform() * 200.0f - 100.0f, uniform() * 200.0f - 100.0f);
+            scene->models.push_back(glm::translate(glm::mat4(1.0f), position));
+        }
+        scene->view = glm::lookAt(glm::vec3(60.0f, 80.0f, 250.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        scene->sort.reserve(count);
+
+        GetBenchmarks().push_back({ "depthsort/radix/" + std::to_string(count), "cubies", (double)count,
+            [scene]() { checkOrder(*scene); },
+            [scene]() {
+                const std::vector<uint32_t>& order = scene->sort.sort(scene->models.data(), scene->models.size(), scene->view);
+                DoNotOptimize(order.data());
+            } });
+    }
+    return 0;
+}
+
+static int s_Registered = registerDepthSortBenchmarks();
@@ -0,0 +1,55 @@
+#include "Bench.h"
+
+#include <LightClusters.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Assignment of point lights to the clusters of the view, done on the CPU whenever the camera moves
+
+struct ClusterScene
+{
+    std::vector<PointLight> lights;
+    LightClusters clusters;
+    glm::mat4 view, proj;
+};
+
+// The light at the center of the screen has to be in the cluster at its depth
+static void checkClusters(ClusterScene& scene)
+{
+    scene.clusters.build(scene.lights, scene.view, scene.proj);
+    std::vector<PointLight> probe = { { glm::vec3(0.0f), 1.0f, glm::vec3(1.0f) } };
+    scene.clusters.build(probe, scene.view, scene.proj);
+
+    float depth = 8.0f;
+    int slice = (int)(std::log(depth) * scene.clusters.getDepthScale() + scene.clusters.getDepthBias());
+    int cluster = CLUSTER_GRID_X / 2 + CLUSTER_GRID_X * (CLUSTER_GRID_Y / 2 + CLUSTER_GRID_Y * slice);
+    if(scene.clusters.getClusters()[2 * cluster + 1] != 1) {
+        fprintf(stderr, "clusters: the light at the center isn't in its cluster\n");
+        exit(1);
+    }
+}
+
+static int registerLightingBenchmarks()
+{
+    for(int count : { 16, 64, 256 }) {
+        ClusterScene* scene = new ClusterScene();
+        scene->lights = ScatterPointLights(count, glm::vec3(0.0f), 4.0f);
+        scene->view = glm::lookAt(glm::vec3(0.0f, 0.0f, 8.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        scene->proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+
+        GetBenchmarks().push_back({ "lighting/clusters/" + std::to_string(count), "lights", (double)count,
+            [scene]() { checkClusters(*scene); },
+            [scene]() {
+                scene->clusters.build(scene->lights, scene->view, scene->proj);
+                DoNotOptimize(scene->clusters.getIndices().data());
+            } });
+    }
+    return 0;
+}
+
+static int s_Registered = registerLightingBenchmarks();
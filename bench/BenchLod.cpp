@@ -0,0 +1,60 @@
+#include "Bench.h"
+
+#include <LodSelector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Level of detail selection and cross-fade, updated once per frame from the projected size of the cube
+
+static const float FRAME_TIME = 1.0f / 60.0f;
+static const float FADE_TIME = 0.25f;
+
+// How much of each level is drawn: the level fading in at the fade value, the one fading out at the rest
+static float visibility(const LodSelector& lod, LodLevel level)
+{
+    float fade = lod.isFading() ? -lod.getFadeOut() : 1.0f;
+    float shown = lod.getLevel() == level ? fade : 0.0f;
+    if(lod.isFading() && lod.getPreviousLevel() == level) { shown += 1.0f - fade; }
+    return shown;
+}
+
+// A zoom out across both thresholds within a fade time must not pop: no level appears or vanishes faster than a fade
+static void checkFastZoom()
+{
+    LodSelector lod;
+    lod.setFadeTime(FADE_TIME);
+    lod.update(400.0f, 10.0f, FRAME_TIME);
+
+    // Cubies, then Stickers on the next frame and Box on the one after, all within 0.25 s
+    const float pixels[] = { 400.0f, 100.0f, 10.0f };
+    float maxStep = FRAME_TIME / FADE_TIME + 1e-4f;
+    float previous[3] = { 1.0f, 0.0f, 0.0f };
+    for(int frame = 0; frame < 60; frame++) {
+        lod.update(pixels[std::min(frame, 2)], 10.0f, FRAME_TIME);
+        for(int level = 0; level < 3; level++) {
+            float shown = visibility(lod, (LodLevel)level);
+            if(std::abs(shown - previous[level]) > maxStep) {
+                fprintf(stderr, "lod: level %d popped from %.2f to %.2f on frame %d\n", level, previous[level], shown, frame);
+                exit(1);
+            }
+            previous[level] = shown;
+        }
+    }
+    if(lod.getLevel() != LodLevel::Box || lod.isFading()) {
+        fprintf(stderr, "lod: the zoom didn't settle on the box level\n");
+        exit(1);
+    }
+}
+
+BENCHMARK_REGISTER({ "lod/update", "frames", 1,
+    []() { checkFastZoom(); },
+    []() {
+        static LodSelector lod;
+        static int frame = 0;
+        // Zooms in and out through every level, crossing a threshold every few frames
+        lod.update(200.0f * (1.0f + std::sin(frame++ * 0.1f)), 10.0f, FRAME_TIME);
+        DoNotOptimize(lod.getLevel());
+    } });
@@ -0,0 +1,94 @@
+#include "Bench.h"
+
+#include <Notation.h>
+
+// Parsing and compiling notation, and applying a sequence turn by turn versus as one precomposed permutation
+
+// T-permutation followed by a sequence with slices, rotations and cancellations
+static const char* SEQUENCE = "R U R' U' R' F R2 U' R' U' R U R' F' M2 U M2 U2 M2 U M2 x y' Rw U Rw' U' R U2 R' U' R U' R' y x' "
+    "R L' U2 R' L F2 r U R' U' r' F R F' S E' S' E";
+
+static const std::vector<LayerTurn> s_Turns = []() {
+    std::vector<LayerTurn> turns;
+    ParseMoves(SEQUENCE, turns);
+    return turns;
+}();
+
+static const int APPLICATIONS_PER_RUN = 100;
+
+BENCHMARK_REGISTER({ "notation/parse", "moves", (double)s_Turns.size(),
+    nullptr,
+    []() {
+        std::vector<LayerTurn> turns;
+        ParseMoves(SEQUENCE, turns);
+        DoNotOptimize(turns.data());
+    }
+});
+
+BENCHMARK_REGISTER({ "notation/compile", "moves", (double)s_Turns.size(),
+    nullptr,
+    []() {
+        Algorithm algorithm;
+        Algorithm::compile(SEQUENCE, algorithm);
+        DoNotOptimize(algorithm);
+    }
+});
+
+BENCHMARK_REGISTER({ "notation/applyTurns", "applications", APPLICATIONS_PER_RUN,
+    nullptr,
+    []() {
+        FaceletPermutation state = FaceletPermutation::identity();
+        for(int i = 0; i < APPLICATIONS_PER_RUN; i++) {
+            for(const LayerTurn& turn : s_Turns) {
+                state = state.multiply(FaceletPermutation::fromTurn(turn));
+            }
+        }
+        DoNotOptimize(state);
+    }
+});
+
+BENCHMARK_REGISTER({ "notation/applyCompiled", "applications", APPLICATIONS_PER_RUN,
+    nullptr,
+    []() {
+        static const Algorithm algorithm(s_Turns);
+        FaceletPermutation state = FaceletPermutation::identity();
+        for(int i = 0; i < APPLICATIONS_PER_RUN; i++) {
+            state = state.multiply(algorithm.getPermutation());
+        }
+        DoNotOptimize(state);
+    }
+});
+
+// The sequence applied 1000 times, composing repeatedly versus moving every sticker along its cycle
+
+static const int POWER = 1000;
+
+BENCHMARK_REGISTER({ "notation/powerRepeated", "powers", 1,
+    nullptr,
+    []() {
+        static const Algorithm algorithm(s_Turns);
+        FaceletPermutation state = FaceletPermutation::identity();
+        for(int i = 0; i < POWER; i++) {
+            state = state.multiply(algorithm.getPermutation());
+        }
+        DoNotOptimize(state);
+    }
+});
+
+BENCHMARK_REGISTER({ "notation/powerCycles", "powers", 1,
+    nullptr,
+    []() {
+        static const Algorithm algorithm(s_Turns);
+        FaceletPermutation state = algorithm.getPermutation().power(POWER);
+        DoNotOptimize(state);
+    }
+});
+
+BENCHMARK_REGISTER({ "notation/order", "orders", 1,
+    nullptr,
+    []() {
+        static const Algorithm algorithm(s_Turns);
+        uint64_t order = algorithm.getPermutation().order();
+        DoNotOptimize(order);
+    }
+});
@@ -0,0 +1,134 @@
+#include "Bench.h"
+
+#include <Replay.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Replay encoding, seeking through keyframes versus replaying from the start
+
+static const int EVENT_COUNT = 20000;
+
+// A fixed session: face turns every ~50 ms mixed with cubie drags
+static std::vector<ReplayEvent> makeEvents()
+{
+    std::mt19937 rng(5);
+    std::vector<ReplayEvent> events(EVENT_COUNT);
+    uint64_t time = 0;
+    for(ReplayEvent& event : events) {
+        time += rng() % 100000;
+        event.time = time;
+        if(rng() % 4) {
+            event.type = ReplayEventType::RotateFace;
+            event.args[0] = rng() % 6;
+        } else {
+            event.type = ReplayEventType::TranslateCubie;
+            event.args[0] = rng() % 27;
+            event.values[0] = 0.001f;
+        }
+    }
+    return events;
+}
+
+static const std::vector<ReplayEvent> s_Events = makeEvents();
+
+static std::vector<uint8_t> encode()
+{
+    RubiksCube& cube = RubiksCube::getInstance();
+    cube.reset();
+    ReplayWriter writer;
+    writer.open("", cube);
+    for(const ReplayEvent& event : s_Events) {
+        ApplyReplayEvent(event, cube);
+        writer.write(event, cube);
+    }
+    writer.finish(s_Events.back().time);
+    return writer.getBytes();
+}
+
+BENCHMARK_REGISTER({ "replay/encode", "events", EVENT_COUNT,
+    nullptr,
+    []() {
+        std::vector<uint8_t> bytes = encode();
+        DoNotOptimize(bytes.data());
+    }
+});
+
+BENCHMARK_REGISTER({ "replay/seekKeyframe", "seeks", 100,
+    nullptr,
+    []() {
+        static ReplayPlayer player;
+        static bool loaded = player.load(encode());
+        RubiksCube& cube = RubiksCube::getInstance();
+        for(int i = 0; i < 100; i++) {
+            player.seek(player.getDuration() * ((i * 37) % 100) / 100.0, cube);
+        }
+        DoNotOptimize(loaded);
+    }
+});
+
+// Seeking step by step, as while a seek key is held, must land on the same cube as one seek to the end
+static void checkHeldSeek()
+{
+    std::vector<uint8_t> bytes = encode();
+    ReplayPlayer held, direct;
+    held.load(bytes);
+    direct.load(bytes);
+    RubiksCube& cube = RubiksCube::getInstance();
+
+    double target = held.getDuration() / 3.0;
+    for(double seconds = 0.0; seconds < target; seconds += 1.0 / 60.0) {
+        held.seek(seconds, cube);
+    }
+    held.seek(target, cube);
+    std::array<Cubie, 27> cubes;
+    std::copy(cube.getCubes(), cube.getCubes() + 27, cubes.begin());
+
+    direct.seek(target, cube);
+    for(int i = 0; i < 27; i++) {
+        const Cubie& cubie = cube.getCubes()[i];
+        if(cubie.id != cubes[i].id || glm::length(cubie.position - cubes[i].position) > 1e-4f) {
+            fprintf(stderr, "replay: held seek left cubie %d elsewhere than a direct seek\n", i);
+            exit(1);
+        }
+    }
+}
+
+BENCHMARK_REGISTER({ "replay/seekHeld", "seeks", 60,
+    []() { checkHeldSeek(); },
+    []() {
+        static ReplayPlayer player;
+        static bool loaded = player.load(encode());
+        static double seconds = 0.0;
+        RubiksCube& cube = RubiksCube::getInstance();
+        // One second of a held seek key at 60 steps a second, wrapping around at the end
+        for(int i = 0; i < 60; i++) {
+            seconds += 1.0 / 60.0;
+            if(seconds > player.getDuration()) { seconds = 0.0; }
+            player.seek(seconds, cube);
+        }
+        DoNotOptimize(loaded);
+    }
+});
+
+BENCHMARK_REGISTER({ "replay/seekFromStart", "seeks", 1,
+    nullptr,
+    []() {
+        static std::vector<uint8_t> bytes = encode();
+        static ReplayReader reader;
+        static bool loaded = reader.load(bytes);
+        RubiksCube& cube = RubiksCube::getInstance();
+        cube.reset();
+        uint64_t offset = reader.getKeyframe(0).offset;
+        uint64_t time = 0;
+        ReplayEvent event;
+        while(reader.read(offset, time, event, nullptr) && event.time <= reader.getDuration() / 2) {
+            ApplyReplayEvent(event, cube);
+            time = event.time;
+        }
+        DoNotOptimize(loaded);
+    }
+});
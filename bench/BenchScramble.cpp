@@ -0,0 +1,56 @@
+#include "Bench.h"
+
+#include <Scrambler.h>
+
+// Random-state scrambles: drawing a state, solving it with the two-phase solver and the whole generator
+
+static const int SCRAMBLES_PER_RUN = 20;
+
+static std::vector<CubeState> makeStates(int count, uint64_t seed)
+{
+    Xoshiro256 random(seed);
+    std::vector<CubeState> states;
+    for(int i = 0; i < count; i++) {
+        states.push_back(RandomState(random));
+    }
+    return states;
+}
+
+// Fixed states so that every run measures the same work
+static const std::vector<CubeState> s_Scrambled = makeStates(SCRAMBLES_PER_RUN, 7);
+
+BENCHMARK_REGISTER({ "scramble/randomState", "states", 1000,
+    nullptr,
+    []() {
+        static Xoshiro256 random(1);
+        for(int i = 0; i < 1000; i++) {
+            CubeState state = RandomState(random);
+            DoNotOptimize(state);
+        }
+    }
+});
+
+BENCHMARK_REGISTER({ "scramble/twoPhase", "solves", SCRAMBLES_PER_RUN,
+    // The first solver builds the shared tables
+    []() { TwoPhaseSolver solver; },
+    []() {
+        static TwoPhaseSolver solver;
+        std::vector<int> moves;
+        for(const CubeState& state : s_Scrambled) {
+            solver.solve(state, moves, SCRAMBLE_MAX_LENGTH);
+            DoNotOptimize(moves.data());
+        }
+    }
+});
+
+BENCHMARK_REGISTER({ "scramble/next", "scrambles", SCRAMBLES_PER_RUN,
+    nullptr,
+    []() {
+        static Scrambler scrambler(11);
+        std::vector<int> moves;
+        for(int i = 0; i < SCRAMBLES_PER_RUN; i++) {
+            scrambler.next(moves);
+            DoNotOptimize(moves.data());
+        }
+    }
+});
@@ -0,0 +1,128 @@
+#include "Bench.h"
+
+#include <CubeState.h>
+
+#include <random>
+#include <unordered_set>
+
+// Compact state encoding: reading the cubies, packing, hashing and symmetry reduction
+
+static const int STATES_PER_RUN = 1000;
+
+// Fixed pseudo-random states so that every run measures the same work
+static std::vector<CubeState> makeStates(int count, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> move(0, MOVE_COUNT - 1);
+    std::vector<CubeState> states(count, CubeState::solved());
+    for(CubeState& state : states) {
+        for(int i = 0; i < 25; i++) {
+            state.applyMove(move(rng));
+        }
+    }
+    return states;
+}
+
+static const std::vector<CubeState> s_States = makeStates(STATES_PER_RUN, 3);
+
+static std::vector<PackedState> makePacked()
+{
+    std::vector<PackedState> packed;
+    for(const CubeState& state : s_States) {
+        packed.push_back(state.pack());
+    }
+    return packed;
+}
+
+static const std::vector<PackedState> s_Packed = makePacked();
+
+BENCHMARK_REGISTER({ "state/fromCubies", "states", 1,
+    []() {
+        RubiksCube& cube = RubiksCube::getInstance();
+        cube.reset();
+        for(int face : { 3, 4, 0, 5, 2, 1, 3, 3, 4 }) {
+            cube.rotateFace(face);
+        }
+    },
+    []() {
+        CubeState state;
+        CubeState::fromCubies(RubiksCube::getInstance().getCubes(), state);
+        DoNotOptimize(state);
+    }
+});
+
+BENCHMARK_REGISTER({ "state/applyMove", "moves", STATES_PER_RUN,
+    nullptr,
+    []() {
+        CubeState state = CubeState::solved();
+        for(int i = 0; i < STATES_PER_RUN; i++) {
+            state.applyMove(i % MOVE_COUNT);
+        }
+        DoNotOptimize(state);
+    }
+});
+
+BENCHMARK_REGISTER({ "state/packHash", "states", STATES_PER_RUN,
+    nullptr,
+    []() {
+        uint64_t sum = 0;
+        for(const CubeState& state : s_States) {
+            sum += state.hash();
+        }
+        DoNotOptimize(sum);
+    }
+});
+
+BENCHMARK_REGISTER({ "state/equalPacked", "compares", STATES_PER_RUN,
+    nullptr,
+    []() {
+        int equal = 0;
+        for(int i = 0; i < STATES_PER_RUN; i++) {
+            equal += s_Packed[i] == s_Packed[(i * 7) % STATES_PER_RUN];
+        }
+        DoNotOptimize(equal);
+    }
+});
+
+BENCHMARK_REGISTER({ "state/canonical", "states", 100,
+    nullptr,
+    []() {
+        for(int i = 0; i < 100; i++) {
+            PackedState canonical = s_States[i].canonical();
+            DoNotOptimize(canonical);
+        }
+    }
+});
+
+// Insert every state then look all of them up again, against the standard library set
+BENCHMARK_REGISTER({ "state/transpositionTable", "states", STATES_PER_RUN,
+    nullptr,
+    []() {
+        static TranspositionTable table(2 * STATES_PER_RUN);
+        table.clear();
+        for(int i = 0; i < STATES_PER_RUN; i++) {
+            table.insert(s_Packed[i], i);
+        }
+        int found = 0;
+        for(const PackedState& packed : s_Packed) {
+            found += table.find(packed) != nullptr;
+        }
+        DoNotOptimize(found);
+    }
+});
+
+BENCHMARK_REGISTER({ "state/unorderedSet", "states", STATES_PER_RUN,
+    nullptr,
+    []() {
+        std::unordered_set<PackedState, PackedStateHasher> set;
+        set.reserve(2 * STATES_PER_RUN);
+        for(const PackedState& packed : s_Packed) {
+            set.insert(packed);
+        }
+        int found = 0;
+        for(const PackedState& packed : s_Packed) {
+            found += set.count(packed) != 0;
+        }
+        DoNotOptimize(found);
+    }
+});
@@ -0,0 +1,102 @@
+#include "Bench.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <TransformBatch.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// The cubie model/MVP computation for one and many puzzles: the per-cubie glm path against the batch kernels
+
+struct TransformScene
+{
+    std::vector<Cubie> cubies;
+    std::vector<glm::mat4> mvps;
+    TransformBatch batch;
+    glm::mat4 view, proj;
+};
+
+static TransformScene* makeScene(unsigned int count)
+{
+    TransformScene* scene = new TransformScene();
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    scene->cubies.resize(count);
+    scene->mvps.resize(count);
+    for(unsigned int i = 0; i < count; i++) {
+        scene->cubies[i].position = glm::vec3(dist(rng), dist(rng), dist(rng)) * 10.0f;
+        scene->cubies[i].rotationMatrix = glm::rotate(glm::mat4(1.0f), dist(rng) * 3.14159f, glm::normalize(glm::vec3(dist(rng), dist(rng), 1.0f)));
+        scene->cubies[i].id = i % 27;
+    }
+    scene->view = glm::lookAt(glm::vec3(0.0f, 0.0f, 8.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    scene->proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    return scene;
+}
+
+// The path used by main.cpp before batching: translate * rotate * scale, then proj * view * model
+static void computeGlm(TransformScene& scene)
+{
+    for(size_t i = 0; i < scene.cubies.size(); i++) {
+        glm::mat4 trans = glm::translate(glm::mat4(1.0f), scene.cubies[i].position);
+        glm::mat4 rot = scene.cubies[i].rotationMatrix;
+        glm::mat4 scl = glm::scale(glm::mat4(1.0f), glm::vec3(CUBIE_SCALE));
+        glm::mat4 model = trans * rot * scl;
+        scene.mvps[i] = scene.proj * scene.view * model;
+    }
+}
+
+static void computeBatch(TransformScene& scene, TransformKernel kernel)
+{
+    scene.batch.load(scene.cubies.data(), (unsigned int)scene.cubies.size());
+    scene.batch.compute(scene.proj * scene.view, nullptr, scene.mvps.data(), kernel);
+}
+
+// The kernels have to agree with glm before they are worth timing
+static void checkKernel(TransformScene& scene, TransformKernel kernel)
+{
+    computeGlm(scene);
+    std::vector<glm::mat4> reference = scene.mvps;
+    computeBatch(scene, kernel);
+
+    float error = 0.0f;
+    for(size_t i = 0; i < reference.size(); i++) {
+        for(int c = 0; c < 4; c++) {
+            error = glm::max(error, glm::length(scene.mvps[i][c] - reference[i][c]));
+        }
+    }
+    if(error > 1e-3f) {
+        fprintf(stderr, "%s kernel differs from glm by %g\n", TransformBatch::getKernelName(kernel), error);
+        exit(1);
+    }
+}
+
+static int registerTransformBenchmarks()
+{
+    const TransformKernel kernels[3] = { TransformKernel::Scalar, TransformKernel::SSE, TransformKernel::AVX2 };
+
+    // One puzzle, a small scene and a large scene
+    for(unsigned int count : { 27u, 27u * 37u, 27u * 1000u }) {
+        TransformScene* scene = makeScene(count);
+        std::string suffix = "/" + std::to_string(count);
+
+        GetBenchmarks().push_back({ "transform/glm" + suffix, "cubies", (double)count,
+            nullptr, [scene]() { computeGlm(*scene); DoNotOptimize(scene->mvps[0]); } });
+
+        for(TransformKernel kernel : kernels) {
+            if(kernel > TransformBatch::getBestKernel()) { continue; }
+
+            std::string name = std::string("transform/") + TransformBatch::getKernelName(kernel) + suffix;
+            GetBenchmarks().push_back({ name, "cubies", (double)count,
+                [scene, kernel]() { checkKernel(*scene, kernel); },
+                [scene, kernel]() { computeBatch(*scene, kernel); DoNotOptimize(scene->mvps[0]); } });
+        }
+    }
+    return 0;
+}
+
+static int s_Registered = registerTransformBenchmarks();
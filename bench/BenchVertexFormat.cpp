@@ -0,0 +1,85 @@
+#include "Bench.h"
+
+#include <CubeMesh.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Vertex fetch of a scene with its own vertices for every cubie, as the GPU would read it: float vs packed vertices
+
+// Cubies of the scene, enough for the vertex data to stay out of the caches (about 16 puzzles of a 6x6x6)
+const int SCENE_CUBIES = 4096;
+
+template<typename Vertex, typename Index>
+struct FetchScene
+{
+    std::vector<Vertex> vertices;
+    std::vector<Index> indices;
+    unsigned int meshVertices = 0;
+};
+
+// Read every word of every indexed vertex of every cubie, the bytes a vertex shader invocation pulls in
+template<typename Vertex, typename Index>
+static uint32_t fetchScene(const FetchScene<Vertex, Index>& scene)
+{
+    static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0, "vertices are read as words");
+    uint32_t sum = 0;
+    for(int cubie = 0; cubie < SCENE_CUBIES; cubie++) {
+        const Vertex* mesh = &scene.vertices[(size_t)cubie * scene.meshVertices];
+        for(Index index : scene.indices) {
+            uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+            memcpy(words, &mesh[index], sizeof(Vertex));
+            for(uint32_t word : words) {
+                sum += word;
+            }
+        }
+    }
+    return sum;
+}
+
+template<typename Vertex, typename Index>
+static void registerFetch(const char* name, FetchScene<Vertex, Index>* scene)
+{
+    std::string bytes = std::to_string(sizeof(Vertex)) + "B+" + std::to_string(sizeof(Index) * 8) + "bit";
+    GetBenchmarks().push_back({ std::string("vertexformat/") + name + "-" + bytes + "/fetch", "vertices",
+        (double)scene->indices.size() * SCENE_CUBIES, nullptr,
+        [scene]() { DoNotOptimize(fetchScene(*scene)); } });
+}
+
+static int registerVertexFormatBenchmarks()
+{
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    BuildBeveledCubieMesh(vertices, indices, 0.06f);    // bevel of CubeRenderer
+    unsigned int meshVertices = (unsigned int)(vertices.size() / CUBE_VERTEX_FLOATS);
+
+    auto* full = new FetchScene<CubeVertex, uint32_t>();
+    full->meshVertices = meshVertices;
+    full->indices = indices;
+    for(int cubie = 0; cubie < SCENE_CUBIES; cubie++) {
+        const CubeVertex* mesh = reinterpret_cast<const CubeVertex*>(vertices.data());
+        full->vertices.insert(full->vertices.end(), mesh, mesh + meshVertices);
+    }
+    registerFetch("float", full);
+
+    // IndexBuffer narrows the indices of the packed mesh, bytes for the 96 vertices of the cubie
+    auto* packed = new FetchScene<PackedCubeVertex, uint8_t>();
+    std::vector<PackedCubeVertex> packedMesh;
+    PackCubeVertices(vertices, packedMesh);
+    packed->meshVertices = meshVertices;
+    packed->indices.assign(indices.begin(), indices.end());
+    for(int cubie = 0; cubie < SCENE_CUBIES; cubie++) {
+        packed->vertices.insert(packed->vertices.end(), packedMesh.begin(), packedMesh.end());
+    }
+    registerFetch("packed", packed);
+
+    GetBenchmarks().push_back({ "vertexformat/pack", "vertices", (double)meshVertices, nullptr,
+        [vertices, packedMesh]() mutable {
+            PackCubeVertices(vertices, packedMesh);
+            DoNotOptimize(packedMesh.data());
+        } });
+    return 0;
+}
+
+static int s_Registered = registerVertexFormatBenchmarks();
@@ -0,0 +1,151 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+Usage: bench [--filter <substring>] [--samples <n>] [--warmup <ms>] [--json <file>]
+    --filter   only run benchmarks whose name contains the substring
+    --samples  number of timed samples per benchmark (default 50)
+    --warmup   warmup time per benchmark in milliseconds (default 100)
+    --json     write the results as JSON to the file ("-" for stdout)
+*/
+
+// Minimal time of a sample, batches of runs are sized to reach it
+const double SAMPLE_NANOSECONDS = 2e6;
+
+std::vector<Benchmark>& GetBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+static double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double timeRuns(const Benchmark& benchmark, unsigned long long runs)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned long long r = 0; r < runs; r++) {
+        benchmark.run();
+    }
+    return nanosecondsSince(start);
+}
+
+// Nearest-rank percentile of sorted samples
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+static BenchmarkResult runBenchmark(const Benchmark& benchmark, int samples, double warmupMilliseconds)
+{
+    if(benchmark.setup) { benchmark.setup(); }
+
+    // Warmup, also used to find how many runs fill a sample
+    unsigned long long runs = 1;
+    double elapsed = 0.0;
+    auto warmupStart = std::chrono::steady_clock::now();
+    while(nanosecondsSince(warmupStart) < warmupMilliseconds * 1e6 || elapsed < SAMPLE_NANOSECONDS) {
+        elapsed = timeRuns(benchmark, runs);
+        if(elapsed < SAMPLE_NANOSECONDS) {
+            runs *= 2;
+        }
+    }
+
+    std::vector<double> times;
+    times.reserve(samples);
+    for(int s = 0; s < samples; s++) {
+        if(benchmark.setup) { benchmark.setup(); }
+        times.push_back(timeRuns(benchmark, runs) / (double)runs);
+    }
+    std::sort(times.begin(), times.end());
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.unit = benchmark.unit;
+    result.itemsPerRun = benchmark.itemsPerRun;
+    result.runsPerSample = runs;
+    result.min = times.front();
+    result.max = times.back();
+    result.p50 = percentile(times, 50.0);
+    result.p90 = percentile(times, 90.0);
+    result.p99 = percentile(times, 99.0);
+    double sum = 0.0;
+    for(double t : times) {
+        sum += t;
+    }
+    result.mean = sum / times.size();
+    result.throughput = benchmark.itemsPerRun * 1e9 / result.p50;
+    return result;
+}
+
+static void writeJson(FILE* file, const std::vector<BenchmarkResult>& results)
+{
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for(size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"unit\": \"%s\", \"items_per_run\": %g, \"runs_per_sample\": %llu, "
+            "\"ns_min\": %.3f, \"ns_mean\": %.3f, \"ns_p50\": %.3f, \"ns_p90\": %.3f, \"ns_p99\": %.3f, \"ns_max\": %.3f, "
+            "\"items_per_second\": %.1f}%s\n",
+            r.name.c_str(), r.unit.c_str(), r.itemsPerRun, r.runsPerSample,
+            r.min, r.mean, r.p50, r.p90, r.p99, r.max, r.throughput, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    int samples = 50;
+    double warmupMilliseconds = 100.0;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if(!strcmp(argv[i], "--samples") && i + 1 < argc) {
+            samples = std::max(1, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--warmup") && i + 1 < argc) {
+            warmupMilliseconds = atof(argv[++i]);
+        } else if(!strcmp(argv[i], "--json") && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--filter <substring>] [--samples <n>] [--warmup <ms>] [--json <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Keep the table on stderr when the JSON goes to stdout
+    FILE* table = jsonPath && !strcmp(jsonPath, "-") ? stderr : stdout;
+    fprintf(table, "%-36s %12s %12s %12s %12s %16s\n", "benchmark", "p50 (ns)", "p90 (ns)", "p99 (ns)", "min (ns)", "throughput");
+
+    std::vector<BenchmarkResult> results;
+    for(const Benchmark& benchmark : GetBenchmarks()) {
+        if(filter && benchmark.name.find(filter) == std::string::npos) { continue; }
+
+        BenchmarkResult r = runBenchmark(benchmark, samples, warmupMilliseconds);
+        fprintf(table, "%-36s %12.1f %12.1f %12.1f %12.1f %10.3g %s/s\n",
+            r.name.c_str(), r.p50, r.p90, r.p99, r.min, r.throughput, r.unit.c_str());
+        fflush(table);
+        results.push_back(r);
+    }
+
+    if(jsonPath) {
+        FILE* file = !strcmp(jsonPath, "-") ? stdout : fopen(jsonPath, "w");
+        if(!file) {
+            fprintf(stderr, "Failed to open %s\n", jsonPath);
+            return 1;
+        }
+        writeJson(file, results);
+        if(file != stdout) { fclose(file); }
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <AllocationCounter.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<unsigned long long> s_Count(0);
+static std::atomic<unsigned long long> s_Bytes(0);
+
+unsigned long long AllocationCounter::getCount()
+{
+    return s_Count.load(std::memory_order_relaxed);
+}
+
+unsigned long long AllocationCounter::getBytes()
+{
+    return s_Bytes.load(std::memory_order_relaxed);
+}
+
+static void* countedAlloc(std::size_t size)
+{
+    s_Count.fetch_add(1, std::memory_order_relaxed);
+    s_Bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+// The array, nothrow and sized forms of the standard library forward to these
+void* operator new(std::size_t size)
+{
+    void* pointer = countedAlloc(size);
+    if(!pointer) { throw std::bad_alloc(); }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+// Over-aligned types: the block starts with room for the alignment, the pointer malloc returned is kept before it
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    std::size_t align = (std::size_t)alignment;
+    void* raw = countedAlloc(size + align + sizeof(void*));
+    if(!raw) { throw std::bad_alloc(); }
+    uintptr_t aligned = ((uintptr_t)raw + sizeof(void*) + align - 1) & ~(uintptr_t)(align - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    if(pointer) { std::free(((void**)pointer)[-1]); }
+}
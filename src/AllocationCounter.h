@@ -0,0 +1,12 @@
+#pragma once
+
+/*
+Counts the heap allocations of the program, all threads included, by replacing the global operator new (see
+AllocationCounter.cpp). Allocations made with malloc by C libraries and drivers aren't seen.
+*/
+class AllocationCounter
+{
+    public:
+        static unsigned long long getCount();
+        static unsigned long long getBytes();
+};
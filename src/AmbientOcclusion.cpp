@@ -0,0 +1,100 @@
+#include <AmbientOcclusion.h>
+
+#include <Profiler.h>
+#include <Renderer.h>
+
+// Reach of the samples in world units, a bit more than the bevel around the stickers
+const float RADIUS = 0.25f;
+
+// How dark a fully occluded pixel gets
+const float STRENGTH = 0.8f;
+
+// Share of the history in the accumulated occlusion
+const float HISTORY_WEIGHT = 0.9f;
+
+AmbientOcclusion::AmbientOcclusion(bool enabled)
+    : m_Enabled(enabled)
+{
+    m_Shader = std::make_unique<Shader>("res/shaders/ssao.shader");
+    m_CompositeShader = std::make_unique<Shader>("res/shaders/ssao_composite.shader");
+    m_FullscreenVa = VertexArray::GetShared(nullptr, EMPTY_VERTEX_FORMAT);
+    m_ProfilerPass = Profiler::getInstance().registerPass("SSAO");
+}
+
+void AmbientOcclusion::setEnabled(bool enabled)
+{
+    m_Enabled = enabled;
+    m_HistoryValid = false;
+    m_StillFrames = 0;
+}
+
+void AmbientOcclusion::setCamera(const glm::mat4& view, const glm::mat4& projection)
+{
+    m_PreviousView = m_View;
+    m_PreviousProjection = m_Projection;
+    m_View = view;
+    m_Projection = projection;
+    if(view != m_PreviousView || projection != m_PreviousProjection) {
+        m_StillFrames = 0;
+    }
+}
+
+void AmbientOcclusion::compute(const FrameBuffer& scene)
+{
+    Profiler::getInstance().beginPass(m_ProfilerPass);
+
+    int width = (scene.GetWidth() + 1) / 2, height = (scene.GetHeight() + 1) / 2;
+    for(std::unique_ptr<FrameBuffer>& occlusion : m_Occlusion) {
+        if(!occlusion) {
+            occlusion = std::make_unique<FrameBuffer>(width, height, 1, GL_RG16F);
+            m_HistoryValid = false;
+        } else if(occlusion->GetWidth() != width || occlusion->GetHeight() != height) {
+            occlusion->Resize(width, height);
+            m_HistoryValid = false;
+        }
+    }
+
+    const FrameBuffer& history = *m_Occlusion[m_Current];
+    m_Current = 1 - m_Current;
+    const FrameBuffer& target = *m_Occlusion[m_Current];
+
+    target.Bind();
+    GLCall(glViewport(0, 0, width, height));
+    scene.BindDepthTexture(0);
+    history.BindTexture(1);
+
+    m_Shader->Bind();
+    m_Shader->SetUniform1i("u_Depth", 0);
+    m_Shader->SetUniform1i("u_History", 1);
+    m_Shader->SetUniform2f("u_InverseDepthSize", glm::vec2(1.0f / scene.GetWidth(), 1.0f / scene.GetHeight()));
+    m_Shader->SetUniformMat4f("u_Projection", m_Projection);
+    m_Shader->SetUniformMat4f("u_InverseProjection", glm::inverse(m_Projection));
+    m_Shader->SetUniformMat4f("u_PreviousProjection", m_PreviousProjection);
+    m_Shader->SetUniformMat4f("u_ViewToPreviousView", m_PreviousView * glm::inverse(m_View));
+    m_Shader->SetUniform1f("u_Radius", RADIUS);
+    m_Shader->SetUniform1f("u_HistoryWeight", m_HistoryValid ? HISTORY_WEIGHT : 0.0f);
+    m_Shader->SetUniform1i("u_Frame", m_Frame);
+    Renderer::DrawFullscreen(*m_FullscreenVa, *m_Shader);
+
+    m_HistoryValid = true;
+    m_Frame++;
+    m_StillFrames++;
+}
+
+void AmbientOcclusion::composite(const FrameBuffer& scene)
+{
+    GLCall(glViewport(0, 0, scene.GetWidth(), scene.GetHeight()));
+    scene.BindTexture(0);
+    scene.BindDepthTexture(1);
+    m_Occlusion[m_Current]->BindTexture(2);
+
+    m_CompositeShader->Bind();
+    m_CompositeShader->SetUniform1i("u_Texture", 0);
+    m_CompositeShader->SetUniform1i("u_Depth", 1);
+    m_CompositeShader->SetUniform1i("u_Occlusion", 2);
+    m_CompositeShader->SetUniformMat4f("u_InverseProjection", glm::inverse(m_Projection));
+    m_CompositeShader->SetUniform1f("u_Strength", STRENGTH);
+    Renderer::DrawFullscreen(*m_FullscreenVa, *m_CompositeShader);
+
+    Profiler::getInstance().endPass(m_ProfilerPass);
+}
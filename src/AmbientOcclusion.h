@@ -0,0 +1,62 @@
+#pragma once
+
+#include <FrameBuffer.h>
+#include <Shader.h>
+#include <VertexArray.h>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+// Frames drawn after the view or the cubies changed until the accumulated occlusion settled
+static constexpr int SSAO_CONVERGENCE_FRAMES = 20;
+
+/*
+Screen-space ambient occlusion darkening the gaps and bevels between cubies. It is computed from the depth of the
+resolved scene at half resolution with a few samples that rotate every frame, averaged over frames with the
+reprojected result of the last one, then upsampled with weights following the depth so it doesn't bleed across
+the silhouettes of the cubies.
+*/
+class AmbientOcclusion
+{
+    private:
+        bool m_Enabled;
+
+        // Half resolution visibility and view depth, this frame and the last one
+        std::unique_ptr<FrameBuffer> m_Occlusion[2];
+        int m_Current = 0;
+        bool m_HistoryValid = false;
+
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<Shader> m_CompositeShader;
+        std::shared_ptr<VertexArray> m_FullscreenVa;
+
+        glm::mat4 m_View = glm::mat4(1.0f);
+        glm::mat4 m_Projection = glm::mat4(1.0f);
+        glm::mat4 m_PreviousView = glm::mat4(1.0f);
+        glm::mat4 m_PreviousProjection = glm::mat4(1.0f);
+        int m_Frame = 0;
+        int m_StillFrames = 0;
+
+        // GPU time of compute() and composite() in the profiler report
+        int m_ProfilerPass;
+
+    public:
+        // Needs the OpenGL context to be current
+        AmbientOcclusion(bool enabled);
+
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return m_Enabled; }
+
+        // Camera of the frame, before compute()
+        void setCamera(const glm::mat4& view, const glm::mat4& projection);
+        // The cubies moved, the accumulation starts again
+        void restart() { m_StillFrames = 0; }
+        // Whether the next frames still change the result although the scene doesn't
+        bool isConverging() const { return m_Enabled && m_StillFrames < SSAO_CONVERGENCE_FRAMES; }
+
+        // Occlusion of a single-sampled scene with a depth texture, changes the bound framebuffer and viewport
+        void compute(const FrameBuffer& scene);
+        // Scene color times the upsampled occlusion into the bound framebuffer, with the viewport of the scene
+        void composite(const FrameBuffer& scene);
+};
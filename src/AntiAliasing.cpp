@@ -0,0 +1,76 @@
+#include <AntiAliasing.h>
+
+#include <Renderer.h>
+
+#include <algorithm>
+
+AntiAliasing::AntiAliasing(int samples, bool fxaa)
+    : m_Samples(std::min(std::max(samples, 1), FrameBuffer::GetMaxSamples())), m_Fxaa(fxaa)
+{
+    if(m_Fxaa) {
+        m_FxaaShader = std::make_unique<Shader>("res/shaders/fxaa.shader");
+        m_FullscreenVa = VertexArray::GetShared(nullptr, EMPTY_VERTEX_FORMAT);
+    }
+}
+
+void AntiAliasing::beginScene(int width, int height)
+{
+    // Minimized window, keep the targets for when it is restored
+    m_SceneOcclusion = false;
+    if(width <= 0 || height <= 0) { return; }
+
+    m_SceneOcclusion = m_Occlusion && m_Occlusion->isEnabled();
+    if(m_Samples > 1) {
+        if(!m_Multisampled) { m_Multisampled = std::make_unique<FrameBuffer>(width, height, m_Samples); }
+        m_Multisampled->Resize(width, height);
+    }
+    if(m_Fxaa || m_SceneOcclusion) {
+        if(!m_Resolved) { m_Resolved = std::make_unique<FrameBuffer>(width, height); }
+        m_Resolved->Resize(width, height);
+    }
+    if(m_Fxaa && m_SceneOcclusion) {
+        if(!m_Composited) { m_Composited = std::make_unique<FrameBuffer>(width, height); }
+        m_Composited->Resize(width, height);
+    }
+
+    if(m_Multisampled) {
+        m_Multisampled->Bind();
+    } else if(m_Fxaa || m_SceneOcclusion) {
+        m_Resolved->Bind();
+    }
+}
+
+void AntiAliasing::endScene()
+{
+    bool postProcess = m_Fxaa || m_SceneOcclusion;
+    if(m_Multisampled) {
+        m_Multisampled->Resolve(postProcess ? m_Resolved.get() : nullptr, m_SceneOcclusion);
+    }
+    if(!postProcess || !m_Resolved) { return; }
+
+    // Every pixel is written, the depth of the window isn't
+    GLCall(glDisable(GL_DEPTH_TEST));
+
+    const FrameBuffer* source = m_Resolved.get();
+    if(m_SceneOcclusion) {
+        m_Occlusion->compute(*m_Resolved);
+        if(m_Fxaa) {
+            m_Composited->Bind();
+            source = m_Composited.get();
+        } else {
+            m_Resolved->Unbind();
+        }
+        m_Occlusion->composite(*m_Resolved);
+    }
+
+    if(m_Fxaa) {
+        source->Unbind();
+        source->BindTexture(0);
+        m_FxaaShader->Bind();
+        m_FxaaShader->SetUniform1i("u_Texture", 0);
+        m_FxaaShader->SetUniform2f("u_InverseSize", glm::vec2(1.0f / source->GetWidth(), 1.0f / source->GetHeight()));
+        Renderer::DrawFullscreen(*m_FullscreenVa, *m_FxaaShader);
+    }
+
+    GLCall(glEnable(GL_DEPTH_TEST));
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <AmbientOcclusion.h>
+#include <FrameBuffer.h>
+#include <Shader.h>
+#include <VertexArray.h>
+
+#include <memory>
+
+/*
+Offscreen scene target with MSAA and an optional FXAA pass:
+    samples > 1, no FXAA:   scene -> multisampled buffer -> blit resolve -> window
+    samples > 1, FXAA:      scene -> multisampled buffer -> blit resolve -> texture -> FXAA -> window
+    samples <= 1, FXAA:     scene -> texture -> FXAA -> window
+    samples <= 1, no FXAA:  scene -> window
+With ambient occlusion, the scene is always resolved into a texture along with its depth, and the occluded scene
+is composited into the window, or into a second texture when FXAA follows.
+*/
+class AntiAliasing
+{
+    private:
+        int m_Samples;
+        bool m_Fxaa;
+        AmbientOcclusion* m_Occlusion = nullptr;
+        // Whether the occlusion was enabled when the scene began, it may be toggled in between
+        bool m_SceneOcclusion = false;
+
+        std::unique_ptr<FrameBuffer> m_Multisampled;
+        std::unique_ptr<FrameBuffer> m_Resolved;
+        std::unique_ptr<FrameBuffer> m_Composited;
+        std::unique_ptr<Shader> m_FxaaShader;
+        std::shared_ptr<VertexArray> m_FullscreenVa;
+
+    public:
+        // Samples are clamped to what the driver supports. Needs the OpenGL context to be current.
+        AntiAliasing(int samples, bool fxaa);
+
+        int getSamples() const { return m_Samples; }
+        bool isFxaaEnabled() const { return m_Fxaa; }
+
+        // Applied between the resolve and FXAA while it is enabled, null for none
+        void setAmbientOcclusion(AmbientOcclusion* occlusion) { m_Occlusion = occlusion; }
+
+        // Redirect the drawing of the scene, the targets follow the size of the window
+        void beginScene(int width, int height);
+
+        // Resolve the scene into the window, which stays bound afterwards
+        void endScene();
+};
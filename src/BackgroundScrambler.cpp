@@ -0,0 +1,63 @@
+#include <BackgroundScrambler.h>
+
+#include <iostream>
+
+BackgroundScrambler::~BackgroundScrambler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_one();
+    if(m_Thread.joinable()) { m_Thread.join(); }
+}
+
+void BackgroundScrambler::start(uint64_t seed)
+{
+    if(m_Thread.joinable()) { return; }
+    m_Thread = std::thread(&BackgroundScrambler::run, this, seed);
+}
+
+void BackgroundScrambler::run(uint64_t seed)
+{
+    Scrambler scrambler(seed);
+
+    std::vector<int> moves;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while(true) {
+        m_Wake.wait(lock, [this]() { return m_Stop || m_Requested; });
+        if(m_Stop) { return; }
+        m_Requested = false;
+
+        lock.unlock();
+        scrambler.next(moves);
+        lock.lock();
+
+        m_Scramble = moves;
+        m_HasScramble = true;
+        if(m_OnReady) { m_OnReady(); }
+    }
+}
+
+void BackgroundScrambler::requestScramble()
+{
+    if(!m_Thread.joinable()) {
+        std::cout << "Scrambler: not started" << std::endl;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requested = true;
+    }
+    m_Wake.notify_one();
+}
+
+bool BackgroundScrambler::pollScramble(std::vector<int>& moves)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(!m_HasScramble) { return false; }
+
+    moves = m_Scramble;
+    m_HasScramble = false;
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Scrambler.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Random-state scrambles (S key) generated off the main thread: building the two-phase tables and solving take long
+enough to freeze the window. The worker builds its Scrambler once started, then one scramble per request.
+*/
+class BackgroundScrambler
+{
+    private:
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        bool m_Stop = false;
+        bool m_Requested = false;
+        bool m_HasScramble = false;
+        std::vector<int> m_Scramble;
+        std::function<void()> m_OnReady;
+
+        BackgroundScrambler() = default;
+        ~BackgroundScrambler();
+
+        void run(uint64_t seed);
+
+    public:
+        static BackgroundScrambler &getInstance() {
+            static BackgroundScrambler instance;
+            return instance;
+        }
+
+        // Start the worker, it builds the solver tables right away so the first request doesn't wait for them
+        void start(uint64_t seed);
+
+        // Generate a scramble in the background, picked up with pollScramble. Requests while busy are merged.
+        void requestScramble();
+        bool pollScramble(std::vector<int>& moves);
+
+        // Called from the worker once a scramble can be polled, e.g. to wake up an idle main loop
+        void setOnReady(std::function<void()> onReady) { m_OnReady = std::move(onReady); }
+};
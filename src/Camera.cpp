@@ -1,6 +1,13 @@
 #include <Camera.h>
 
 #include "Debugger.h"
+#include "Renderer.h"
+#include "TransformBatch.h"
+#include "OptimalSolver.h"
+#include "BackgroundScrambler.h"
+#include "Replay.h"
+#include "FrameScheduler.h"
+#include <glm/gtc/quaternion.hpp>
 #include <GLFW/glfw3.h>
 
 const float EPS = 0.5f; 
@@ -15,6 +22,7 @@ void Camera::SetOrthographic(float near, float far)
     // Reset Projection and View matrices
     m_Projection = glm::ortho(m_Left, m_Right, m_Bottom, m_Top, near, far);
     m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    m_ChangeCount++;
 }
 
 void Camera::setPerspective(float FOVdegree, float near, float far)
@@ -25,11 +33,13 @@ void Camera::setPerspective(float FOVdegree, float near, float far)
 
     m_Projection = glm::perspective(glm::radians(FOVdegree), aspect, near, far);
     m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    m_ChangeCount++;
 }
 
 void Camera::updateViewMatrix()
 {
     m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    m_ChangeCount++;
 }
 
 void Camera::updatePosition(const float delta)
@@ -38,6 +48,13 @@ void Camera::updatePosition(const float delta)
     updateViewMatrix();
 }
 
+void Camera::lookAt(const glm::vec3& position, const glm::vec3& target)
+{
+    m_Position = position;
+    m_Orientation = glm::normalize(target - position);
+    updateViewMatrix();
+}
+
 void Camera::rotate()
 {
     float angleX = m_NewMouseX / glm::pi<float>();
@@ -127,27 +144,22 @@ void Camera::pickCubie(double x, double y)
     RubiksCube& cube = RubiksCube::getInstance();
     Cubie *cubes = cube.getCubes();
 
+    // Calculate Model-View-Projection matrices of all cubies
+    TransformBatch transforms;
+    transforms.load(cubes, 27);
+    glm::mat4 mvps[27];
+    transforms.compute(m_Projection * m_View, nullptr, mvps);
+
     // Draw each cubie with unique color ID
     for(int i = 0; i < 27; i++) {
 
-        /* Initialize the model Translate, Rotate and Scale matrices */
-        glm::mat4 trans = glm::translate(glm::mat4(1.0f), cubes[i].position);
-        glm::mat4 rot = cubes[i].rotationMatrix;
-        glm::mat4 scl = glm::scale(glm::mat4(1.0f), glm::vec3(CUBIE_SCALE));
-
-        /* Calculate Model-View-Projection matrix */
-        glm::mat4 model = trans * rot * scl;
-        glm::mat4 view = m_View;
-        glm::mat4 proj = m_Projection;
-        glm::mat4 mvp = proj * view * model;
-
         // Generate unique color ID based on cubie's index
         glm::vec4 colorId = encodeColorId(i);
         // printf("Cubie i: %d, Color ID RGBA: (%.3f, %.3f, %.3f, %.3f)\n", i, colorId.r, colorId.g, colorId.b, colorId.a);
         // Draw the cubie
         m_Shader->SetUniform4f("u_Color", colorId);
-        m_Shader->SetUniformMat4f("u_MVP", mvp);
-        GLCall(glDrawElements(GL_TRIANGLES, m_Ibo->GetCount(), GL_UNSIGNED_INT, nullptr));   
+        m_Shader->SetUniformMat4f("u_MVP", mvps[i]);
+        Renderer::Draw(*m_Vao, *m_Ibo, *m_Shader);
     }
 
     // Read pixel color under mouse cursor
@@ -191,6 +203,12 @@ void Camera::rotateCubie()
     glm::mat4 rotY = glm::rotate(glm::mat4(1.0f), angleY * sensitivity, m_XAxis());
 
     m_PickedCubie->rotationMatrix = rotY * rotX  * m_PickedCubie->rotationMatrix;   
+    RubiksCube::getInstance().markChanged();
+
+    glm::quat rotation = glm::quat_cast(glm::mat3(rotY * rotX));
+    float values[4] = { rotation.w, rotation.x, rotation.y, rotation.z };
+    int slot = (int)(m_PickedCubie - RubiksCube::getInstance().getCubes());
+    ReplayRecorder::getInstance().record(ReplayEventType::RotateCubie, slot, values, 4);
 }
 
 void Camera::translateCubie()
@@ -210,6 +228,10 @@ void Camera::translateCubie()
     glm::vec3 worldDelta = currentWorldPos - prevWorldPos;
 
     m_PickedCubie->position += worldDelta;
+    RubiksCube::getInstance().markChanged();
+
+    int slot = (int)(m_PickedCubie - RubiksCube::getInstance().getCubes());
+    ReplayRecorder::getInstance().record(ReplayEventType::TranslateCubie, slot, &worldDelta[0], 3);
 }
 
 /////////////////////
@@ -224,52 +246,92 @@ void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods
         return;
     }
 
+    // Measured from the poll that delivered the input
+    FrameScheduler::getInstance().onInput();
+
     if (action == GLFW_PRESS || action == GLFW_REPEAT)
     {
         RubiksCube &cube = RubiksCube::getInstance();
+        ReplayRecorder &recorder = ReplayRecorder::getInstance();
         switch (key)
         {
             case GLFW_KEY_A:
+            {
                 cube.setRotationAngle(180.0f);
+                float degrees = 180.0f;
+                recorder.record(ReplayEventType::SetRotationAngle, 0, &degrees, 1);
                 break;
+            }
             case GLFW_KEY_Z:
+            {
                 cube.setRotationAngle(90.0f);
+                float degrees = 90.0f;
+                recorder.record(ReplayEventType::SetRotationAngle, 0, &degrees, 1);
                 break;
+            }
             case GLFW_KEY_SPACE:
                 cube.changeRotationDirection();
+                recorder.record(ReplayEventType::ChangeRotationDirection);
                 break;
             case GLFW_KEY_R:
                 cube.rotateFace(3);
+                recorder.record(ReplayEventType::RotateFace, 3);
                 break;
             case GLFW_KEY_L:
                 cube.rotateFace(2);
+                recorder.record(ReplayEventType::RotateFace, 2);
                 break;
             case GLFW_KEY_U:
                 cube.rotateFace(4);
+                recorder.record(ReplayEventType::RotateFace, 4);
                 break;
             case GLFW_KEY_D:
                 cube.rotateFace(5);
+                recorder.record(ReplayEventType::RotateFace, 5);
                 break;
             case GLFW_KEY_B:
                 cube.rotateFace(1);
+                recorder.record(ReplayEventType::RotateFace, 1);
                 break;
             case GLFW_KEY_F:
                 cube.rotateFace(0);
+                recorder.record(ReplayEventType::RotateFace, 0);
                 break;
             case GLFW_KEY_P:
                 camera->toggleColorPicking();
                 break;
+            case GLFW_KEY_O:
+            {
+                CubeState state;
+                if (CubeState::fromCubies(cube.getCubes(), state))
+                {
+                    OptimalSolver::getInstance().requestSolve(state);
+                }
+                else
+                {
+                    std::cout << "Optimal solver: cubies are off the grid" << std::endl;
+                }
+                break;
+            }
+            case GLFW_KEY_S:
+                // Random-state scramble, applied from solved by the main loop once generated
+                BackgroundScrambler::getInstance().requestScramble();
+                break;
             case GLFW_KEY_UP:
                 cube.rotateCube(CUBE_X_AXIS);
+                recorder.record(ReplayEventType::RotateCube, 0);
                 break;
             case GLFW_KEY_DOWN:
                 cube.rotateCube(-CUBE_X_AXIS);
+                recorder.record(ReplayEventType::RotateCube, 3);
                 break;
             case GLFW_KEY_LEFT:
                 cube.rotateCube(-CUBE_Y_AXIS);
+                recorder.record(ReplayEventType::RotateCube, 4);
                 break;  
             case GLFW_KEY_RIGHT:
                 cube.rotateCube(CUBE_Y_AXIS);
+                recorder.record(ReplayEventType::RotateCube, 1);
                 break;
             default:
                 break;
@@ -284,6 +346,9 @@ void MouseButtonCallback(GLFWwindow* window, double currMouseX, double currMouse
         std::cout << "Warning: Camera wasn't set as the Window User Pointer! MouseButtonCallback is skipped" << std::endl;
         return;
     }
+
+    FrameScheduler::getInstance().onInput();
+
     double x, y;
     if (camera->isColorPicking() && glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
     {
@@ -313,6 +378,11 @@ void CursorPosCallback(GLFWwindow* window, double currMouseX, double currMouseY)
     camera->m_OldMouseX = currMouseX;
     camera->m_OldMouseY = currMouseY;
 
+    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS || glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
+    {
+        FrameScheduler::getInstance().onInput();
+    }
+
     if (!camera->isColorPicking() && glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
     {
         camera->rotate();
@@ -340,6 +410,8 @@ void ScrollCallback(GLFWwindow* window, double scrollOffsetX, double scrollOffse
         return;
     }
 
+    FrameScheduler::getInstance().onInput();
+
     // Zoom in and out
     camera->updatePosition((float)scrollOffsetY);
 }
@@ -357,6 +429,15 @@ void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
     camera->updateSize(width, height);
 }
 
+void WindowRefreshCallback(GLFWwindow* window)
+{
+    Camera* camera = (Camera*) glfwGetWindowUserPointer(window);
+    if (!camera) return;
+
+    // The window was uncovered or resized and its contents are stale, redraw even when idle
+    camera->markChanged();
+}
+
 void Camera::EnableInputs(GLFWwindow* window)
 {
     // Set camera as the user pointer for the window
@@ -376,4 +457,7 @@ void Camera::EnableInputs(GLFWwindow* window)
 
     // Handle window resize
     glfwSetFramebufferSizeCallback(window, (void(*)(GLFWwindow *, int, int)) FramebufferSizeCallback);
+
+    // Handle damaged window contents
+    glfwSetWindowRefreshCallback(window, (void(*)(GLFWwindow *)) WindowRefreshCallback);
 }
\ No newline at end of file
@@ -53,6 +53,9 @@ class Camera
         Cubie* m_PickedCubie = nullptr;
         float m_PickedDepth = 0.0f;
 
+        // Incremented whenever the view or projection matrices change
+        unsigned long long m_ChangeCount = 0;
+
         // Update Viewing matrix
         void updateViewMatrix();
 
@@ -78,6 +81,9 @@ class Camera
         // Update camera position
         void updatePosition(const float delta);
 
+        // Place the camera at position, looking at target
+        void lookAt(const glm::vec3& position, const glm::vec3& target);
+
         // Rotates camera postion according to newMouseX and newMouseY
         void rotate();
 
@@ -105,10 +111,17 @@ class Camera
         // Translate cubie under mouse cursor
         void translateCubie();
 
+        // Force the next frame to be drawn, e.g. when the window contents were damaged
+        void markChanged() { m_ChangeCount++; }
+        unsigned long long getChangeCount() const { return m_ChangeCount; }
+
         // Return the axis of the mouse
         glm::vec3 m_XAxis() { return glm::normalize(glm::cross(m_Position - m_Orientation, m_Up)); }
         glm::vec3 m_YAxis() { return glm::normalize(m_Up); }
 
         inline glm::mat4 GetViewMatrix() const { return m_View; }
         inline glm::mat4 GetProjectionMatrix() const { return m_Projection; }
+        inline glm::vec3 GetPosition() const { return m_Position; }
+        inline int GetWidth() const { return m_Width; }
+        inline int GetHeight() const { return m_Height; }
 };
\ No newline at end of file
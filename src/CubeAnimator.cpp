@@ -0,0 +1,73 @@
+#include <CubeAnimator.h>
+
+#include <algorithm>
+
+static const float TURN_SPEED = glm::half_pi<float>() / TURN_DURATION;   // radians per second
+static const float TURN_TOLERANCE = 1e-3f;
+
+CubeAnimator::Pose CubeAnimator::blend(const Pose& from, const Pose& to, float t)
+{
+    glm::quat delta = to.rotation * glm::inverse(from.rotation);
+    if(glm::length(delta * from.position - to.position) < TURN_TOLERANCE) {
+        glm::quat partial = glm::slerp(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), delta, t);
+        return { partial * from.position, glm::normalize(partial * from.rotation) };
+    }
+    return { glm::mix(from.position, to.position, t), glm::slerp(from.rotation, to.rotation, t) };
+}
+
+void CubeAnimator::snap(const Cubie* cubes)
+{
+    for(int i = 0; i < 27; i++) {
+        m_Current[cubes[i].id] = { cubes[i].position, glm::quat_cast(glm::mat3(cubes[i].rotationMatrix)) };
+    }
+    m_Previous = m_Current;
+    m_Started = true;
+}
+
+void CubeAnimator::step(const Cubie* cubes, float seconds)
+{
+    if(!m_Started) { snap(cubes); }
+
+    m_Previous = m_Current;
+    for(int i = 0; i < 27; i++) {
+        Pose& pose = m_Current[cubes[i].id];
+        Pose target = { cubes[i].position, glm::quat_cast(glm::mat3(cubes[i].rotationMatrix)) };
+
+        // Quarter turns at TURN_SPEED, catching up proportionally when several are pending
+        float angle = 2.0f * glm::acos(glm::min(glm::abs(glm::dot(pose.rotation, target.rotation)), 1.0f));
+        float speed = TURN_SPEED * std::max(1.0f, angle / glm::half_pi<float>());
+        float t = angle > TURN_TOLERANCE ? std::min(1.0f, speed * seconds / angle) : 1.0f;
+        pose = blend(pose, target, t);
+        if(t >= 1.0f) { pose = target; }
+    }
+}
+
+const Cubie* CubeAnimator::getCubes(const Cubie* cubes, float alpha)
+{
+    if(!m_Started) { snap(cubes); }
+
+    for(int i = 0; i < 27; i++) {
+        Pose pose = blend(m_Previous[cubes[i].id], m_Current[cubes[i].id], alpha);
+        m_Display[i] = cubes[i];
+        m_Display[i].position = pose.position;
+        m_Display[i].rotationMatrix = glm::mat4_cast(pose.rotation);
+    }
+    return m_Display.data();
+}
+
+bool CubeAnimator::isAnimating(const Cubie* cubes) const
+{
+    if(!m_Started) { return true; }
+
+    for(int i = 0; i < 27; i++) {
+        const Pose& previous = m_Previous[cubes[i].id];
+        const Pose& current = m_Current[cubes[i].id];
+        if(previous.position != current.position || previous.rotation != current.rotation) { return true; }
+
+        // Finished poses are set to their target exactly, see step()
+        if(current.position != cubes[i].position || current.rotation != glm::quat_cast(glm::mat3(cubes[i].rotationMatrix))) {
+            return true;
+        }
+    }
+    return false;
+}
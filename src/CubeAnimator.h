@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RubiksCube.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+
+// Seconds a quarter turn takes on screen, faster when turns queue up
+static constexpr float TURN_DURATION = 0.12f;
+
+/*
+Shown state of the cubies, following the state of RubiksCube: turns apply instantly to the cube and are animated
+here. Cubies are tracked by id, so they keep their place on screen whatever slot they move to. step() runs at the
+fixed simulation rate and getCubes() interpolates between its last two results.
+*/
+class CubeAnimator
+{
+    private:
+        struct Pose
+        {
+            glm::vec3 position;
+            glm::quat rotation;
+        };
+
+        std::array<Pose, 27> m_Previous;
+        std::array<Pose, 27> m_Current;
+        std::array<Cubie, 27> m_Display;
+        bool m_Started = false;
+
+        // From `from` to `to` by t: along the arc around the center for turns, straight for drags
+        static Pose blend(const Pose& from, const Pose& to, float t);
+
+    public:
+        // Move the shown cubies towards the cube by one simulation step
+        void step(const Cubie* cubes, float seconds);
+
+        // Show the cube as it is, e.g. after seeking a replay
+        void snap(const Cubie* cubes);
+
+        // Cubies to draw, `alpha` between the last two steps, in the slot order of `cubes`
+        const Cubie* getCubes(const Cubie* cubes, float alpha);
+
+        // Whether the shown cubies still move: the last step moved them or they haven't reached the cube yet
+        bool isAnimating(const Cubie* cubes) const;
+};
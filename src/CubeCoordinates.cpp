@@ -0,0 +1,52 @@
+#include <CubeCoordinates.h>
+
+uint32_t RankPermutation(const uint8_t* permutation, int n)
+{
+    uint32_t index = 0;
+    for(int i = 0; i < n; i++) {
+        int smaller = 0;
+        for(int j = i + 1; j < n; j++) {
+            smaller += permutation[j] < permutation[i];
+        }
+        index = index * (n - i) + smaller;
+    }
+    return index;
+}
+
+void UnrankPermutation(uint32_t index, uint8_t* permutation, int n)
+{
+    int digits[12];
+    for(int i = n - 1; i >= 0; i--) {
+        digits[i] = index % (n - i);
+        index /= n - i;
+    }
+    bool used[12] = {};
+    for(int i = 0; i < n; i++) {
+        int value = 0;
+        for(int skip = digits[i]; used[value] || skip > 0; value++) {
+            if(!used[value]) { skip--; }
+        }
+        used[value] = true;
+        permutation[i] = value;
+    }
+}
+
+uint32_t RankOrientation(const uint8_t* orientation, int n, int base)
+{
+    uint32_t index = 0;
+    for(int i = 0; i < n - 1; i++) {
+        index = index * base + orientation[i];
+    }
+    return index;
+}
+
+void UnrankOrientation(uint32_t index, uint8_t* orientation, int n, int base)
+{
+    int sum = 0;
+    for(int i = n - 2; i >= 0; i--) {
+        orientation[i] = index % base;
+        index /= base;
+        sum += orientation[i];
+    }
+    orientation[n - 1] = (base - sum % base) % base;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// Ranking of the arrays of CubeState into dense integer coordinates, used to index move and pruning tables
+
+// Lehmer code of a permutation of 0..n-1, n <= 12
+uint32_t RankPermutation(const uint8_t* permutation, int n);
+void UnrankPermutation(uint32_t index, uint8_t* permutation, int n);
+
+// First n-1 orientations as base `base` digits, the last one makes the sum a multiple of base
+uint32_t RankOrientation(const uint8_t* orientation, int n, int base);
+void UnrankOrientation(uint32_t index, uint8_t* orientation, int n, int base);
@@ -0,0 +1,208 @@
+#include <CubeMesh.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+// Tangent axes of each face, cross(u, v) == normal
+static const glm::vec3 FACE_U[6] = {
+    glm::vec3( 1.0f, 0.0f,  0.0f),
+    glm::vec3(-1.0f, 0.0f,  0.0f),
+    glm::vec3( 0.0f, 0.0f,  1.0f),
+    glm::vec3( 0.0f, 0.0f, -1.0f),
+    glm::vec3( 1.0f, 0.0f,  0.0f),
+    glm::vec3( 1.0f, 0.0f,  0.0f),
+};
+
+static const glm::vec3 FACE_V[6] = {
+    glm::vec3(0.0f, 1.0f,  0.0f),
+    glm::vec3(0.0f, 1.0f,  0.0f),
+    glm::vec3(0.0f, 1.0f,  0.0f),
+    glm::vec3(0.0f, 1.0f,  0.0f),
+    glm::vec3(0.0f, 0.0f, -1.0f),
+    glm::vec3(0.0f, 0.0f,  1.0f),
+};
+
+const glm::vec3 PLASTIC_COLOR = glm::vec3(0.05f, 0.05f, 0.05f);
+const float STICKER_HALF_SIZE = 0.45f;
+
+static void pushVertex(std::vector<float>& vertices, const glm::vec3& position, const glm::vec3& color, const glm::vec2& texCoord, const glm::vec3& normal)
+{
+    vertices.insert(vertices.end(), {
+        position.x, position.y, position.z,
+        color.r, color.g, color.b,
+        texCoord.x, texCoord.y,
+        normal.x, normal.y, normal.z
+    });
+}
+
+static void pushQuad(std::vector<unsigned int>& indices, unsigned int first)
+{
+    indices.insert(indices.end(), { first, first + 1, first + 2, first + 2, first + 3, first });
+}
+
+static unsigned int vertexCount(const std::vector<float>& vertices)
+{
+    return (unsigned int)(vertices.size() / CUBE_VERTEX_FLOATS);
+}
+
+void PackCubeVertices(const std::vector<float>& vertices, std::vector<PackedCubeVertex>& packed)
+{
+    packed.resize(vertexCount(vertices));
+    for(size_t v = 0; v < packed.size(); v++) {
+        const float* in = &vertices[v * CUBE_VERTEX_FLOATS];
+        PackedCubeVertex& out = packed[v];
+        for(int c = 0; c < 3; c++) {
+            out.position.value[c] = glm::packHalf1x16(in[c]);
+        }
+        out.position.value[3] = glm::packHalf1x16(1.0f);
+        out.color = glm::u8vec4(glm::round(glm::clamp(glm::vec4(in[3], in[4], in[5], 1.0f), 0.0f, 1.0f) * 255.0f));
+        out.texCoord.value[0] = glm::packHalf1x16(in[6]);
+        out.texCoord.value[1] = glm::packHalf1x16(in[7]);
+        out.normal.value = glm::packSnorm3x10_1x2(glm::vec4(in[8], in[9], in[10], 0.0f));
+    }
+}
+
+// Position of a cubie in the solved cube, each component in {-1, 0, 1}
+static glm::ivec3 homeOfCubie(int id)
+{
+    return glm::ivec3(id / 9 - 1, (id / 3) % 3 - 1, id % 3 - 1);
+}
+
+// Face whose normal is closest to the given direction
+static int faceOfDirection(const glm::vec3& direction)
+{
+    int best = 0;
+    for(int f = 1; f < 6; f++) {
+        if(glm::dot(direction, FACE_NORMALS[f]) > glm::dot(direction, FACE_NORMALS[best])) {
+            best = f;
+        }
+    }
+    return best;
+}
+
+void BuildBeveledCubieMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, float bevel)
+{
+    vertices.clear();
+    indices.clear();
+
+    const float inner = 0.5f - bevel;
+
+    // Stickers: the face inset by the bevel
+    for(int f = 0; f < 6; f++) {
+        glm::vec3 n = FACE_NORMALS[f] * 0.5f, u = FACE_U[f] * inner, v = FACE_V[f] * inner;
+        unsigned int first = vertexCount(vertices);
+        pushVertex(vertices, n - u - v, FACE_COLORS[f], glm::vec2(0.0f, 0.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n + u - v, FACE_COLORS[f], glm::vec2(1.0f, 0.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n + u + v, FACE_COLORS[f], glm::vec2(1.0f, 1.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n - u + v, FACE_COLORS[f], glm::vec2(0.0f, 1.0f), FACE_NORMALS[f]);
+        pushQuad(indices, first);
+    }
+
+    if(bevel <= 0.0f) { return; }
+
+    // Edges: a strip between every pair of adjacent faces
+    for(int a = 0; a < 6; a++) {
+        for(int b = a + 1; b < 6; b++) {
+            glm::vec3 na = FACE_NORMALS[a], nb = FACE_NORMALS[b];
+            if(glm::dot(na, nb) != 0.0f) { continue; }
+
+            glm::vec3 e = glm::cross(na, nb) * inner;
+            glm::vec3 normal = glm::normalize(na + nb);
+            unsigned int first = vertexCount(vertices);
+            pushVertex(vertices, na * 0.5f + nb * inner - e, PLASTIC_COLOR, glm::vec2(0.0f), normal);
+            pushVertex(vertices, na * 0.5f + nb * inner + e, PLASTIC_COLOR, glm::vec2(0.0f), normal);
+            pushVertex(vertices, nb * 0.5f + na * inner + e, PLASTIC_COLOR, glm::vec2(0.0f), normal);
+            pushVertex(vertices, nb * 0.5f + na * inner - e, PLASTIC_COLOR, glm::vec2(0.0f), normal);
+            pushQuad(indices, first);
+        }
+    }
+
+    // Corners: a triangle joining the three faces meeting at every corner
+    for(int corner = 0; corner < 8; corner++) {
+        glm::vec3 s = glm::vec3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f);
+        glm::vec3 normal = glm::normalize(s);
+        unsigned int first = vertexCount(vertices);
+        pushVertex(vertices, s * glm::vec3(0.5f, inner, inner), PLASTIC_COLOR, glm::vec2(0.0f), normal);
+        pushVertex(vertices, s * glm::vec3(inner, 0.5f, inner), PLASTIC_COLOR, glm::vec2(0.0f), normal);
+        pushVertex(vertices, s * glm::vec3(inner, inner, 0.5f), PLASTIC_COLOR, glm::vec2(0.0f), normal);
+        indices.insert(indices.end(), { first, first + 1, first + 2 });
+    }
+}
+
+void BuildStickerStrips(std::vector<unsigned int>& indices)
+{
+    // Corners 0 1 2 3 go around the quad, the strip 0 1 3 2 keeps the winding of pushQuad
+    indices.clear();
+    for(unsigned int i = 0; i < STICKER_COUNT; i++) {
+        unsigned int first = i * 4;
+        if(i > 0) { indices.push_back(PRIMITIVE_RESTART); }
+        indices.insert(indices.end(), { first, first + 1, first + 3, first + 2 });
+    }
+}
+
+void BuildStickerVertices(const Cubie* cubes, std::vector<float>& vertices)
+{
+    vertices.clear();
+    for(int i = 0; i < 27; i++) {
+        glm::ivec3 home = homeOfCubie(cubes[i].id);
+        glm::mat3 rot = glm::mat3(cubes[i].rotationMatrix) * CUBIE_SCALE;
+
+        for(int f = 0; f < 6; f++) {
+            // Only the outer faces of the solved cubie carry a sticker
+            if(glm::dot(glm::vec3(home), FACE_NORMALS[f]) < 0.5f) { continue; }
+
+            glm::vec3 n = FACE_NORMALS[f] * 0.5f;
+            glm::vec3 u = FACE_U[f] * STICKER_HALF_SIZE, v = FACE_V[f] * STICKER_HALF_SIZE;
+            glm::vec3 normal = glm::normalize(rot * FACE_NORMALS[f]);
+            pushVertex(vertices, cubes[i].position + rot * (n - u - v), FACE_COLORS[f], glm::vec2(0.0f, 0.0f), normal);
+            pushVertex(vertices, cubes[i].position + rot * (n + u - v), FACE_COLORS[f], glm::vec2(1.0f, 0.0f), normal);
+            pushVertex(vertices, cubes[i].position + rot * (n + u + v), FACE_COLORS[f], glm::vec2(1.0f, 1.0f), normal);
+            pushVertex(vertices, cubes[i].position + rot * (n - u + v), FACE_COLORS[f], glm::vec2(0.0f, 1.0f), normal);
+        }
+    }
+}
+
+void BuildBoxMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+{
+    vertices.clear();
+    indices.clear();
+
+    // The box encloses all 27 cubies
+    const float halfExtent = 1.5f * CUBIE_SCALE;
+    const glm::vec3 white = glm::vec3(1.0f);
+
+    for(int f = 0; f < 6; f++) {
+        glm::vec3 n = FACE_NORMALS[f] * halfExtent, u = FACE_U[f] * halfExtent, v = FACE_V[f] * halfExtent;
+        float left = (float)(f * 3) / FACE_ATLAS_WIDTH, right = (float)(f * 3 + 3) / FACE_ATLAS_WIDTH;
+        unsigned int first = vertexCount(vertices);
+        pushVertex(vertices, n - u - v, white, glm::vec2(left, 0.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n + u - v, white, glm::vec2(right, 0.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n + u + v, white, glm::vec2(right, 1.0f), FACE_NORMALS[f]);
+        pushVertex(vertices, n - u + v, white, glm::vec2(left, 1.0f), FACE_NORMALS[f]);
+        pushQuad(indices, first);
+    }
+}
+
+void BakeFaceColors(const Cubie* cubes, unsigned char* pixels)
+{
+    for(int i = 0; i < 27; i++) {
+        glm::ivec3 home = homeOfCubie(cubes[i].id);
+        glm::mat3 rot = glm::mat3(cubes[i].rotationMatrix);
+
+        for(int f = 0; f < 6; f++) {
+            if(glm::dot(glm::vec3(home), FACE_NORMALS[f]) < 0.5f) { continue; }
+
+            // Find the face the sticker currently points to and its cell on that face
+            int face = faceOfDirection(rot * FACE_NORMALS[f]);
+            glm::vec3 center = cubes[i].position / CUBIE_SCALE;
+            int column = glm::clamp((int)glm::round(glm::dot(center, FACE_U[face])), -1, 1) + 1;
+            int row = glm::clamp((int)glm::round(glm::dot(center, FACE_V[face])), -1, 1) + 1;
+
+            unsigned char* texel = pixels + 4 * (row * FACE_ATLAS_WIDTH + face * 3 + column);
+            texel[0] = (unsigned char)(FACE_COLORS[f].r * 255.0f);
+            texel[1] = (unsigned char)(FACE_COLORS[f].g * 255.0f);
+            texel[2] = (unsigned char)(FACE_COLORS[f].b * 255.0f);
+            texel[3] = 255;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "IndexBuffer.h"
+#include "RubiksCube.h"
+#include "VertexBufferLayout.h"
+
+#include <vector>
+
+/*
+FaceIndex (same order as RubiksCube::rotateFace):
+    0: Front face,
+    1: Back face,
+    2: Left face,
+    3: Right face,
+    4: Top face,
+    5: Bottom face
+*/
+static constexpr glm::vec3 FACE_NORMALS[6] = {
+    glm::vec3( 0.0f,  0.0f,  1.0f),
+    glm::vec3( 0.0f,  0.0f, -1.0f),
+    glm::vec3(-1.0f,  0.0f,  0.0f),
+    glm::vec3( 1.0f,  0.0f,  0.0f),
+    glm::vec3( 0.0f,  1.0f,  0.0f),
+    glm::vec3( 0.0f, -1.0f,  0.0f),
+};
+
+static constexpr glm::vec3 FACE_COLORS[6] = {
+    glm::vec3(1.0f, 1.0f, 1.0f), // white (opposite of yellow)
+    glm::vec3(1.0f, 1.0f, 0.0f), // yellow (opposite of white)
+    glm::vec3(0.0f, 0.0f, 1.0f), // blue (opposite of green)
+    glm::vec3(0.0f, 1.0f, 0.0f), // green (opposite of blue)
+    glm::vec3(1.0f, 0.5f, 0.0f), // orange (opposite of red)
+    glm::vec3(1.0f, 0.0f, 0.0f), // red (opposite of orange)
+};
+
+// Number of floats per vertex: position (3), color (3), texCoord (2), normal (3)
+static constexpr int CUBE_VERTEX_FLOATS = 11;
+
+// Vertex of the meshes below, they are written as flat float arrays
+struct CubeVertex
+{
+    glm::vec3 position;
+    glm::vec3 color;
+    glm::vec2 texCoord;
+    glm::vec3 normal;
+};
+static_assert(sizeof(CubeVertex) == CUBE_VERTEX_FLOATS * sizeof(float), "CubeVertex must match the float layout");
+
+static constexpr auto CUBE_VERTEX_FORMAT = MakeVertexFormat<CubeVertex>(
+    VERTEX_ATTRIBUTE(CubeVertex, position),
+    VERTEX_ATTRIBUTE(CubeVertex, color),
+    VERTEX_ATTRIBUTE(CubeVertex, texCoord),
+    VERTEX_ATTRIBUTE(CubeVertex, normal)
+);
+
+// CubeVertex in 20 bytes instead of 44: half float position (w = 1) and texCoord, byte color, 10-bit normal
+struct PackedCubeVertex
+{
+    Half4 position;
+    glm::u8vec4 color;
+    Half2 texCoord;
+    PackedNormal normal;
+};
+static_assert(sizeof(PackedCubeVertex) == 20, "PackedCubeVertex must not be padded");
+
+static constexpr auto PACKED_CUBE_VERTEX_FORMAT = MakeVertexFormat<PackedCubeVertex>(
+    VERTEX_ATTRIBUTE(PackedCubeVertex, position),
+    VERTEX_ATTRIBUTE(PackedCubeVertex, color),
+    VERTEX_ATTRIBUTE(PackedCubeVertex, texCoord),
+    VERTEX_ATTRIBUTE(PackedCubeVertex, normal)
+);
+
+// Per-instance matrix, one attribute per column
+struct MatrixInstance
+{
+    glm::vec4 column0;
+    glm::vec4 column1;
+    glm::vec4 column2;
+    glm::vec4 column3;
+};
+static_assert(sizeof(MatrixInstance) == sizeof(glm::mat4), "MatrixInstance must match glm::mat4");
+
+static constexpr auto MATRIX_INSTANCE_FORMAT = MakeVertexFormat<MatrixInstance>(
+    VERTEX_ATTRIBUTE(MatrixInstance, column0),
+    VERTEX_ATTRIBUTE(MatrixInstance, column1),
+    VERTEX_ATTRIBUTE(MatrixInstance, column2),
+    VERTEX_ATTRIBUTE(MatrixInstance, column3)
+);
+
+// Number of stickers on a 3x3 cube
+static constexpr int STICKER_COUNT = 54;
+
+// Size of the face color atlas baked by BakeFaceColors (6 faces of 3x3 texels side by side)
+static constexpr int FACE_ATLAS_WIDTH = 18;
+static constexpr int FACE_ATLAS_HEIGHT = 3;
+
+// Unit cubie with colored stickers and dark beveled edges and corners of width `bevel` (0 for a plain cube)
+void BuildBeveledCubieMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, float bevel);
+
+// Convert vertices of CUBE_VERTEX_FLOATS floats to the packed format, positions and texCoords must fit in half floats
+void PackCubeVertices(const std::vector<float>& vertices, std::vector<PackedCubeVertex>& packed);
+
+// Triangle strips of the quads written by BuildStickerVertices, separated by PRIMITIVE_RESTART (see IndexBuffer.h):
+// 5 indices per sticker instead of the 6 of a triangle list
+void BuildStickerStrips(std::vector<unsigned int>& indices);
+
+// One world space quad per sticker of the current cube state (STICKER_COUNT quads, 4 vertices each)
+void BuildStickerVertices(const Cubie* cubes, std::vector<float>& vertices);
+
+// Single box around the whole cube, textured from the face color atlas
+void BuildBoxMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices);
+
+// Writes the sticker colors of the current cube state into a FACE_ATLAS_WIDTH x FACE_ATLAS_HEIGHT RGBA image
+void BakeFaceColors(const Cubie* cubes, unsigned char* pixels);
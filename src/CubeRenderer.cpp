@@ -0,0 +1,329 @@
+#include <CubeRenderer.h>
+
+#include <CubeMesh.h>
+#include <FrameArena.h>
+#include <Renderer.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+// Width of the dark bevel around the stickers of a cubie
+const float BEVEL = 0.06f;
+
+// Radius of the sphere bounding a whole cube, used for level of detail selection
+const float CUBE_RADIUS = 1.5f * CUBIE_SCALE * 1.7320508f;
+
+// Radius of the sphere bounding the unit cubie mesh
+const float CUBIE_RADIUS = 0.5f * 1.7320508f;
+
+// Distance between the centers of two copies of the cube
+const float PUZZLE_SPACING = 4.0f;
+
+// First attributes of the instance MVP and Model matrices, see instanced.shader
+const unsigned int INSTANCE_ATTRIBUTE = 4;
+const unsigned int MODEL_ATTRIBUTE = 8;
+
+// Opacity of the cubies in x-ray mode
+const float X_RAY_ALPHA = 0.35f;
+
+// Point lights are spread this far from the center, relative to the radius of the scene
+const float POINT_LIGHT_DISTANCE = 1.5f;
+
+CubeRenderer::CubeRenderer(bool packedVertices)
+{
+    /* Build the beveled cubie mesh */
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    BuildBeveledCubieMesh(vertices, indices, BEVEL);
+
+    /* Generate VAO, VBO, EBO and bind them, the instanced VAOs read the same vertices plus their instance attributes */
+    m_InstancedVa = std::make_unique<VertexArray>();
+    m_SortedVa = std::make_unique<VertexArray>();
+    if(packedVertices) {
+        std::vector<PackedCubeVertex> packed;
+        PackCubeVertices(vertices, packed);
+        m_MeshVertexBytes = (unsigned int)(packed.size() * sizeof(PackedCubeVertex));
+        m_Vb = std::make_unique<VertexBuffer>(packed.data(), m_MeshVertexBytes);
+        m_Va = VertexArray::GetShared(m_Vb.get(), PACKED_CUBE_VERTEX_FORMAT);
+        m_InstancedVa->AddBuffer(*m_Vb, PACKED_CUBE_VERTEX_FORMAT);
+        m_SortedVa->AddBuffer(*m_Vb, PACKED_CUBE_VERTEX_FORMAT);
+    } else {
+        m_MeshVertexBytes = (unsigned int)(vertices.size() * sizeof(float));
+        m_Vb = std::make_unique<VertexBuffer>(vertices.data(), m_MeshVertexBytes);
+        m_Va = VertexArray::GetShared(m_Vb.get(), CUBE_VERTEX_FORMAT);
+        m_InstancedVa->AddBuffer(*m_Vb, CUBE_VERTEX_FORMAT);
+        m_SortedVa->AddBuffer(*m_Vb, CUBE_VERTEX_FORMAT);
+    }
+
+    /* Packed meshes also get the narrowest index type for their vertex count, float ones stay 32-bit as they were */
+    m_Ib = std::make_unique<IndexBuffer>(indices.data(), indices.size() * sizeof(unsigned int), GL_TRIANGLES, packedVertices);
+    m_MeshIndexBytes = m_Ib->GetSize();
+    createInstanceBuffer();
+
+    /* Create texture */
+    m_Texture = std::make_unique<Texture>("res/textures/plane.png");
+    m_Texture->Bind();
+
+    /* Create shaders */
+    m_Shader = std::make_unique<Shader>("res/shaders/basic.shader");
+    m_InstancedShader = std::make_unique<Shader>("res/shaders/instanced.shader");
+    m_ShadowShader = std::make_unique<Shader>("res/shaders/shadow.shader");
+    m_TransparentShader = std::make_unique<Shader>("res/shaders/oit.shader");
+
+    /* Unbind all to prevent accidentally modifying them */
+    m_Va->Unbind();
+    m_Vb->Unbind();
+    m_Ib->Unbind();
+    m_Shader->Unbind();
+
+    m_Transforms.resize(27);
+}
+
+void CubeRenderer::createInstanceBuffer()
+{
+    unsigned int instances = 27 * m_PuzzleCount;
+    m_Mvps.resize(instances);
+    m_Models.resize(instances);
+    m_ShadowModels.clear();
+    m_UploadedModels.clear();
+    m_ShadowsDirty = true;
+    m_InstanceVb = std::make_unique<VertexBuffer>(nullptr, instances * sizeof(glm::mat4), GL_DYNAMIC_DRAW);
+    m_ModelVb = std::make_unique<VertexBuffer>(nullptr, instances * sizeof(glm::mat4), GL_DYNAMIC_DRAW);
+
+    m_InstancedVa->AddInstanceBuffer(*m_InstanceVb, MATRIX_INSTANCE_FORMAT, INSTANCE_ATTRIBUTE);
+    m_InstancedVa->AddInstanceBuffer(*m_ModelVb, MATRIX_INSTANCE_FORMAT, MODEL_ATTRIBUTE);
+    m_InstancedVa->Unbind();
+
+    m_DepthSort.reserve(instances);
+    m_SortedMvpVb = std::make_unique<VertexBuffer>(nullptr, instances * sizeof(glm::mat4), GL_DYNAMIC_DRAW);
+    m_SortedModelVb = std::make_unique<VertexBuffer>(nullptr, instances * sizeof(glm::mat4), GL_DYNAMIC_DRAW);
+    m_SortedVa->AddInstanceBuffer(*m_SortedMvpVb, MATRIX_INSTANCE_FORMAT, INSTANCE_ATTRIBUTE);
+    m_SortedVa->AddInstanceBuffer(*m_SortedModelVb, MATRIX_INSTANCE_FORMAT, MODEL_ATTRIBUTE);
+    m_SortedVa->Unbind();
+}
+
+void CubeRenderer::setPuzzleCount(int count)
+{
+    if(count < 1 || count == m_PuzzleCount) { return; }
+
+    m_PuzzleCount = count;
+    createInstanceBuffer();
+    setPointLightCount(m_PointLightCount);
+}
+
+void CubeRenderer::setPointLightCount(int count)
+{
+    m_PointLightCount = count;
+    m_Lighting.setPointLights(ScatterPointLights(count, glm::vec3(0.0f), POINT_LIGHT_DISTANCE * getSceneRadius()));
+}
+
+glm::vec3 CubeRenderer::getPuzzleOffset(int puzzle) const
+{
+    int columns = (int)std::ceil(std::sqrt((float)m_PuzzleCount));
+    int rows = (m_PuzzleCount + columns - 1) / columns;
+    float x = (puzzle % columns - (columns - 1) * 0.5f) * PUZZLE_SPACING;
+    float y = (puzzle / columns - (rows - 1) * 0.5f) * PUZZLE_SPACING;
+    return glm::vec3(x, y, 0.0f);
+}
+
+float CubeRenderer::getSceneRadius() const
+{
+    float radius = 0.0f;
+    for(int p = 0; p < m_PuzzleCount; p++) {
+        radius = glm::max(radius, glm::length(getPuzzleOffset(p)));
+    }
+    return radius + CUBE_RADIUS;
+}
+
+void CubeRenderer::computeTransforms(const glm::mat4& viewProjection, const Cubie* cubes)
+{
+    /* Calculate Model and Model-View-Projection matrices (Translate * Rotate * Scale) of all cubies of all copies */
+    m_Transforms.load(cubes, 27);
+    for(int p = 0; p < m_PuzzleCount; p++) {
+        glm::vec3 offset = getPuzzleOffset(p);
+        glm::mat4 puzzle = glm::translate(glm::mat4(1.0f), offset);
+        m_Transforms.compute(viewProjection * puzzle, &m_Models[27 * p], &m_Mvps[27 * p]);
+        // The batch computes models of the cube at the origin, the copy's translation is added afterwards
+        for(int i = 27 * p; i < 27 * (p + 1); i++) {
+            m_Models[i][3] += glm::vec4(offset, 0.0f);
+        }
+    }
+
+    /* The instanced, transparent and shadow draws read the models from m_ModelVb, whether or not the shadows are redrawn */
+    if(m_UploadedModels != m_Models) {
+        m_ModelVb->SetData(m_Models.data(), m_Models.size() * sizeof(glm::mat4));
+        m_UploadedModels = m_Models;
+    }
+}
+
+void CubeRenderer::updateShadows()
+{
+    /* The shadow map only depends on the cubies, camera moves don't invalidate it */
+    if(!m_ShadowsDirty) { return; }
+    m_ShadowsDirty = false;
+
+    /* Redraw where the cubies that moved were and are now, all of the map after a layout change */
+    ShadowMap& shadowMap = m_Lighting.getShadowMap();
+    ShadowRegion region;
+    bool full = m_ShadowModels.size() != m_Models.size();
+    if(full) {
+        shadowMap.setScene(m_Lighting.getSun().direction, glm::vec3(0.0f), getSceneRadius());
+        region = ShadowRegion::full();
+    } else {
+        for(size_t i = 0; i < m_Models.size(); i++) {
+            if(m_Models[i] == m_ShadowModels[i]) { continue; }
+            // Spheres bounding the unit cubie, scaled like its model
+            region.add(shadowMap.getRegion(glm::vec3(m_ShadowModels[i][3]), CUBIE_RADIUS * glm::length(glm::vec3(m_ShadowModels[i][0]))));
+            region.add(shadowMap.getRegion(glm::vec3(m_Models[i][3]), CUBIE_RADIUS * glm::length(glm::vec3(m_Models[i][0]))));
+        }
+    }
+    if(region.isEmpty()) { return; }
+    m_ShadowModels = m_Models;
+
+    (full ? m_FullShadowUpdates : m_PartialShadowUpdates)++;
+    m_ShadowTexels += region.getArea();
+
+    /* Cubies outside of the region are drawn too and discarded by the scissor, the vertex work is small */
+    shadowMap.begin(region);
+    m_ShadowShader->Bind();
+    m_ShadowShader->SetUniformMat4f("u_LightViewProjection", shadowMap.getLightViewProjection());
+    Renderer::DrawInstanced(*m_InstancedVa, *m_Ib, *m_ShadowShader, (unsigned int)m_Models.size());
+    shadowMap.end();
+}
+
+void CubeRenderer::printShadowReport() const
+{
+    if(m_Frames == 0) { return; }
+
+    double texels = (double)SHADOW_MAP_SIZE * SHADOW_MAP_SIZE;
+    printf("Shadow map over %llu frames: %llu full and %llu partial updates, %.1f%% of a full redraw per frame\n",
+        m_Frames, m_FullShadowUpdates, m_PartialShadowUpdates, 100.0 * m_ShadowTexels / texels / m_Frames);
+}
+
+void CubeRenderer::drawCubies(float fade)
+{
+    if(m_Strategy == RenderStrategy::Instanced) {
+        m_InstanceVb->SetData(m_Mvps.data(), m_Mvps.size() * sizeof(glm::mat4));
+        m_InstancedShader->Bind();
+        m_InstancedShader->SetUniform4f("u_Color", glm::vec4(1.0f));
+        m_InstancedShader->SetUniform1i("u_Texture", 0);
+        m_InstancedShader->SetUniform1f("u_Fade", fade);
+        Renderer::DrawInstanced(*m_InstancedVa, *m_Ib, *m_InstancedShader, (unsigned int)m_Mvps.size());
+        m_Shader->Bind();
+        return;
+    }
+
+    /* Draw each cubie */
+    for(size_t i = 0; i < m_Mvps.size(); i++) {
+        m_Shader->SetUniformMat4f("u_MVP", m_Mvps[i]);
+        m_Shader->SetUniformMat4f("u_Model", m_Models[i]);
+        Renderer::Draw(*m_Va, *m_Ib, *m_Shader);
+    }
+}
+
+void CubeRenderer::drawTransparent(const Camera& camera)
+{
+    m_InstanceVb->SetData(m_Mvps.data(), m_Mvps.size() * sizeof(glm::mat4));
+    m_Lighting.apply(*m_TransparentShader, camera);
+    m_Texture->Bind();
+    m_TransparentShader->SetUniform4f("u_Color", glm::vec4(1.0f));
+    m_TransparentShader->SetUniform1i("u_Texture", 0);
+    m_TransparentShader->SetUniform1f("u_Alpha", X_RAY_ALPHA);
+
+    /* Every cubie of every copy in one instanced draw, in array order */
+    m_Transparency.begin(camera.GetWidth(), camera.GetHeight());
+    Renderer::DrawInstanced(*m_InstancedVa, *m_Ib, *m_TransparentShader, (unsigned int)m_Mvps.size());
+    m_Transparency.end();
+}
+
+void CubeRenderer::drawSorted(const Camera& camera)
+{
+    /* Back to front by the depth of the cubie centers, the triangles of a cubie stay in mesh order */
+    const std::vector<uint32_t>& order = m_DepthSort.sort(m_Models.data(), m_Models.size(), camera.GetViewMatrix());
+    glm::mat4* mvps = FrameArena::getInstance().allocate<glm::mat4>(order.size());
+    glm::mat4* models = FrameArena::getInstance().allocate<glm::mat4>(order.size());
+    for(size_t i = 0; i < order.size(); i++) {
+        mvps[i] = m_Mvps[order[i]];
+        models[i] = m_Models[order[i]];
+    }
+    m_SortedMvpVb->SetData(mvps, order.size() * sizeof(glm::mat4));
+    m_SortedModelVb->SetData(models, order.size() * sizeof(glm::mat4));
+
+    m_Lighting.apply(*m_InstancedShader, camera);
+    m_Texture->Bind();
+    m_InstancedShader->SetUniform4f("u_Color", glm::vec4(1.0f, 1.0f, 1.0f, X_RAY_ALPHA));
+    m_InstancedShader->SetUniform1i("u_Texture", 0);
+    m_InstancedShader->SetUniform1f("u_Fade", 0.0f);
+
+    /* Inner cubies show through, nothing is depth tested */
+    GLCall(glDisable(GL_DEPTH_TEST));
+    GLCall(glDepthMask(GL_FALSE));
+    Renderer::DrawInstanced(*m_SortedVa, *m_Ib, *m_InstancedShader, (unsigned int)order.size());
+    GLCall(glDepthMask(GL_TRUE));
+    GLCall(glEnable(GL_DEPTH_TEST));
+}
+
+TransparencyMode CubeRenderer::getTransparencyMode() const
+{
+    return m_Transparency.isSupported() ? m_TransparencyMode : TransparencyMode::Sorted;
+}
+
+void CubeRenderer::draw(const Camera& camera, const Cubie* cubes, float deltaTime)
+{
+    glm::mat4 viewProjection = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+
+    /* Shadows and light clusters first, they are only rebuilt when the cubies or the camera moved */
+    m_Frames++;
+    computeTransforms(viewProjection, cubes);
+    updateShadows();
+    m_Lighting.update(camera);
+    if(m_XRay) {
+        if(getTransparencyMode() == TransparencyMode::Sorted) {
+            drawSorted(camera);
+        } else {
+            drawTransparent(camera);
+        }
+        return;
+    }
+    if(m_Strategy == RenderStrategy::Instanced) {
+        m_Lighting.apply(*m_InstancedShader, camera);
+    }
+    m_Lighting.apply(*m_Shader, camera);
+
+    /* Initialize uniform color */
+    glm::vec4 color = glm::vec4(1.0, 1.0f, 1.0f, 1.0f);
+
+    m_Texture->Bind();
+    m_Shader->Bind();
+    m_Shader->SetUniform4f("u_Color", color);
+    m_Shader->SetUniform1i("u_Texture", 0);
+
+    /* Level of detail is selected for a single cube, copies are always drawn in full */
+    if(!m_LodEnabled || m_PuzzleCount > 1) {
+        m_Shader->SetUniform1f("u_Fade", 0.0f);
+        drawCubies(0.0f);
+        return;
+    }
+
+    /* Select the level of detail from the projected size of the cube */
+    m_Lod.update(camera, glm::vec3(0.0f), CUBE_RADIUS, deltaTime);
+
+    /* While fading, the previous level is drawn with the complementary dither pattern */
+    LodLevel levels[2] = { m_Lod.getLevel(), m_Lod.getPreviousLevel() };
+    float fades[2] = { m_Lod.getFadeIn(), m_Lod.getFadeOut() };
+    int levelCount = m_Lod.isFading() ? 2 : 1;
+
+    for(int l = 0; l < levelCount; l++) {
+        m_Shader->SetUniform1f("u_Fade", fades[l]);
+
+        if(levels[l] == LodLevel::Cubies) {
+            drawCubies(fades[l]);
+        } else {
+            m_LodMeshes.update(levels[l], cubes);
+            m_LodMeshes.draw(levels[l], *m_Shader, viewProjection);
+        }
+    }
+    m_Shader->SetUniform1f("u_Fade", 0.0f);
+}
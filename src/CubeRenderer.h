@@ -0,0 +1,144 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <Camera.h>
+#include <DepthSort.h>
+#include <IndexBuffer.h>
+#include <LevelOfDetail.h>
+#include <Lighting.h>
+#include <Shader.h>
+#include <Texture.h>
+#include <TransformBatch.h>
+#include <Transparency.h>
+#include <VertexArray.h>
+#include <VertexBuffer.h>
+
+#include "RubiksCube.h"
+
+#include <memory>
+#include <vector>
+
+/*
+RenderStrategy:
+    PerCubie: one draw call per cubie with its MVP matrix as a uniform,
+    Instanced: one instanced draw call for all cubies with the MVP matrices in an instance buffer
+*/
+enum class RenderStrategy
+{
+    PerCubie = 0,
+    Instanced = 1
+};
+
+/*
+TransparencyMode of the x-ray mode:
+    WeightedBlended: order-independent, one instanced draw into the targets of Transparency,
+    Sorted: cubies sorted back to front by view depth every frame, then blended in that order
+*/
+enum class TransparencyMode
+{
+    WeightedBlended = 0,
+    Sorted = 1
+};
+
+// Draws one or several copies of the cube, owns the cubie mesh, shaders and level of detail resources
+class CubeRenderer
+{
+    private:
+        std::unique_ptr<VertexBuffer> m_Vb;
+        std::shared_ptr<VertexArray> m_Va;     // shared by the meshes of m_Vb, after it so it goes first
+        std::unique_ptr<IndexBuffer> m_Ib;
+        unsigned int m_MeshVertexBytes = 0;
+        unsigned int m_MeshIndexBytes = 0;
+        std::unique_ptr<Texture> m_Texture;
+        std::unique_ptr<Shader> m_Shader;
+
+        // Instanced path: same mesh, plus one MVP and one Model matrix per instance
+        std::unique_ptr<VertexArray> m_InstancedVa;
+        std::unique_ptr<VertexBuffer> m_InstanceVb;
+        std::unique_ptr<VertexBuffer> m_ModelVb;
+        // Model matrices in m_ModelVb, uploaded again whenever the cubies moved
+        std::vector<glm::mat4> m_UploadedModels;
+        std::unique_ptr<Shader> m_InstancedShader;
+
+        // Depth of the cubies seen from the sun, drawn with the instanced mesh
+        Lighting m_Lighting;
+        std::unique_ptr<Shader> m_ShadowShader;
+        // Model matrices of the last shadow pass; once marked dirty, the cubies that differ are drawn again
+        std::vector<glm::mat4> m_ShadowModels;
+        bool m_ShadowsDirty = true;
+        unsigned long long m_Frames = 0;
+        unsigned long long m_FullShadowUpdates = 0;
+        unsigned long long m_PartialShadowUpdates = 0;
+        long long m_ShadowTexels = 0;
+        int m_PointLightCount = 0;
+
+        // X-ray mode: all cubies translucent through order-independent transparency
+        Transparency m_Transparency;
+        std::unique_ptr<Shader> m_TransparentShader;
+        bool m_XRay = false;
+        TransparencyMode m_TransparencyMode = TransparencyMode::WeightedBlended;
+
+        // Sorted fallback: the instance matrices in back-to-front order, in buffers of their own
+        DepthSort m_DepthSort;
+        std::unique_ptr<VertexArray> m_SortedVa;
+        std::unique_ptr<VertexBuffer> m_SortedMvpVb;
+        std::unique_ptr<VertexBuffer> m_SortedModelVb;
+
+        LodSelector m_Lod;
+        LodMeshes m_LodMeshes;
+
+        TransformBatch m_Transforms;
+        std::vector<glm::mat4> m_Mvps;
+        std::vector<glm::mat4> m_Models;
+
+        RenderStrategy m_Strategy = RenderStrategy::PerCubie;
+        int m_PuzzleCount = 1;
+        bool m_LodEnabled = true;
+
+        void createInstanceBuffer();
+        void computeTransforms(const glm::mat4& viewProjection, const Cubie* cubes);
+        void updateShadows();
+        void drawCubies(float fade);
+        void drawTransparent(const Camera& camera);
+        void drawSorted(const Camera& camera);
+
+    public:
+        // Packed vertices take 20 bytes instead of 44, see PackedCubeVertex
+        CubeRenderer(bool packedVertices = true);
+
+        void setStrategy(RenderStrategy strategy) { m_Strategy = strategy; }
+        // Copies of the cube laid out on a grid, all showing the same state
+        void setPuzzleCount(int count);
+        void setLodEnabled(bool enabled) { m_LodEnabled = enabled; }
+        // See-through cubies showing the inner ones, drawn in any order
+        void setXRay(bool xRay) { m_XRay = xRay; }
+        bool isXRay() const { return m_XRay; }
+        // Weighted blended transparency falls back to sorting when the driver doesn't support its targets
+        void setTransparencyMode(TransparencyMode mode) { m_TransparencyMode = mode; }
+        TransparencyMode getTransparencyMode() const;
+        // Point lights spread around the scene, their count doesn't change the cost of a pixel much
+        void setPointLightCount(int count);
+
+        // The cubies may have moved: a turn, an animation step or a drag. Until then the shadow map is kept as is
+        void markShadowsDirty() { m_ShadowsDirty = true; }
+        // Shadow map updates and the share of its texels they redrew
+        void printShadowReport() const;
+
+        // Center of a copy of the cube and radius of the sphere bounding all of them
+        glm::vec3 getPuzzleOffset(int puzzle) const;
+        float getSceneRadius() const;
+
+        void draw(const Camera& camera, const Cubie* cubes, float deltaTime);
+
+        // Whether the next frame differs even if nothing else changes, i.e. a LOD transition is fading
+        bool isAnimating() const { return m_LodEnabled && m_Lod.isFading(); }
+
+        // Buffers and shader for color picking
+        VertexArray* getVertexArray() { return m_Va.get(); }
+        IndexBuffer* getIndexBuffer() { return m_Ib.get(); }
+        // Size of the cubie mesh on the GPU, read again for every cubie drawn
+        unsigned int getMeshVertexBytes() const { return m_MeshVertexBytes; }
+        unsigned int getMeshIndexBytes() const { return m_MeshIndexBytes; }
+        Shader* getShader() { return m_Shader.get(); }
+};
@@ -0,0 +1,480 @@
+#include <CubeState.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+struct IVec3
+{
+    int x, y, z;
+
+    bool operator==(const IVec3& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+// Solved slots, in the order URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB (right = +x, up = +y, front = +z)
+static const IVec3 CORNER_POSITIONS[CORNER_COUNT] = {
+    { 1, 1, 1 }, { -1, 1, 1 }, { -1, 1, -1 }, { 1, 1, -1 },
+    { 1, -1, 1 }, { -1, -1, 1 }, { -1, -1, -1 }, { 1, -1, -1 }
+};
+
+// UR, UF, UL, UB, DR, DF, DL, DB, then the middle layer FR, FL, BL, BR
+static const IVec3 EDGE_POSITIONS[EDGE_COUNT] = {
+    { 1, 1, 0 }, { 0, 1, 1 }, { -1, 1, 0 }, { 0, 1, -1 },
+    { 1, -1, 0 }, { 0, -1, 1 }, { -1, -1, 0 }, { 0, -1, -1 },
+    { 1, 0, 1 }, { -1, 0, 1 }, { -1, 0, -1 }, { 1, 0, -1 }
+};
+
+// Outward normals of the faces, in RubiksCube::rotateFace order
+static const IVec3 FACE_AXES[6] = {
+    { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+};
+
+static IVec3 cross(const IVec3& a, const IVec3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+static int dot(const IVec3& a, const IVec3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Clockwise quarter turn around an outward axis, seen from outside
+static IVec3 turn(const IVec3& v, const IVec3& axis)
+{
+    IVec3 c = cross(axis, v);
+    int d = dot(axis, v);
+    return { d * axis.x - c.x, d * axis.y - c.y, d * axis.z - c.z };
+}
+
+/*
+Every slot lists the outward directions of its stickers (facelets). Facelet 0 is the reference facelet:
+the U/D sticker for corners and U/D edges, the F/B sticker for middle layer edges. Corner facelets follow the
+same rotational order in every slot, so that twists add up modulo 3.
+*/
+struct Geometry
+{
+    IVec3 cornerFacelets[CORNER_COUNT][3];
+    IVec3 edgeFacelets[EDGE_COUNT][2];
+
+    CubeState moves[MOVE_COUNT];
+
+    // Signed permutation matrix of every symmetry: v'[r] = sign[r] * v[axis[r]]
+    int symmetryAxis[SYMMETRY_COUNT][3];
+    int symmetrySign[SYMMETRY_COUNT][3];
+
+    // Where every slot and every facelet of a slot goes under each symmetry
+    uint8_t cornerSlotMap[SYMMETRY_COUNT][CORNER_COUNT];
+    uint8_t cornerFaceletMap[SYMMETRY_COUNT][CORNER_COUNT][3];
+    uint8_t edgeSlotMap[SYMMETRY_COUNT][EDGE_COUNT];
+    uint8_t edgeFaceletMap[SYMMETRY_COUNT][EDGE_COUNT][2];
+
+    Geometry();
+
+    IVec3 applySymmetry(int s, const IVec3& v) const
+    {
+        int in[3] = { v.x, v.y, v.z };
+        return { symmetrySign[s][0] * in[symmetryAxis[s][0]], symmetrySign[s][1] * in[symmetryAxis[s][1]], symmetrySign[s][2] * in[symmetryAxis[s][2]] };
+    }
+};
+
+static int cornerSlot(const IVec3& position)
+{
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        if(CORNER_POSITIONS[i] == position) { return i; }
+    }
+    return -1;
+}
+
+static int edgeSlot(const IVec3& position)
+{
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        if(EDGE_POSITIONS[i] == position) { return i; }
+    }
+    return -1;
+}
+
+template<int N>
+static int faceletIndex(const IVec3 (&facelets)[N], const IVec3& direction)
+{
+    for(int k = 0; k < N; k++) {
+        if(facelets[k] == direction) { return k; }
+    }
+    return -1;
+}
+
+Geometry::Geometry()
+{
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        const IVec3& p = CORNER_POSITIONS[i];
+        IVec3 x = { p.x, 0, 0 }, y = { 0, p.y, 0 }, z = { 0, 0, p.z };
+        // det[y, x, z] = -x * y * z, swap the last two when negative to keep the same handedness everywhere
+        bool rightHanded = -p.x * p.y * p.z > 0;
+        cornerFacelets[i][0] = y;
+        cornerFacelets[i][1] = rightHanded ? x : z;
+        cornerFacelets[i][2] = rightHanded ? z : x;
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        const IVec3& p = EDGE_POSITIONS[i];
+        IVec3 x = { p.x, 0, 0 }, y = { 0, p.y, 0 }, z = { 0, 0, p.z };
+        edgeFacelets[i][0] = p.y != 0 ? y : z;
+        edgeFacelets[i][1] = p.x != 0 ? x : z;
+    }
+
+    // Quarter turns from the geometry, half and counter-clockwise turns by composition
+    for(int face = 0; face < 6; face++) {
+        const IVec3& axis = FACE_AXES[face];
+        CubeState quarter = CubeState::solved();
+        for(int i = 0; i < CORNER_COUNT; i++) {
+            if(dot(CORNER_POSITIONS[i], axis) != 1) { continue; }
+            int j = cornerSlot(turn(CORNER_POSITIONS[i], axis));
+            quarter.cp[j] = i;
+            quarter.co[j] = faceletIndex(cornerFacelets[j], turn(cornerFacelets[i][0], axis));
+        }
+        for(int i = 0; i < EDGE_COUNT; i++) {
+            if(dot(EDGE_POSITIONS[i], axis) != 1) { continue; }
+            int j = edgeSlot(turn(EDGE_POSITIONS[i], axis));
+            quarter.ep[j] = i;
+            quarter.eo[j] = faceletIndex(edgeFacelets[j], turn(edgeFacelets[i][0], axis));
+        }
+        moves[face * 3 + 0] = quarter;
+        moves[face * 3 + 1] = quarter.multiply(quarter);
+        moves[face * 3 + 2] = moves[face * 3 + 1].multiply(quarter);
+    }
+
+    // 6 axis permutations times 8 sign combinations
+    static const int PERMUTATIONS[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+    for(int s = 0; s < SYMMETRY_COUNT; s++) {
+        for(int r = 0; r < 3; r++) {
+            symmetryAxis[s][r] = PERMUTATIONS[s / 8][r];
+            symmetrySign[s][r] = (s >> r) & 1 ? -1 : 1;
+        }
+        for(int i = 0; i < CORNER_COUNT; i++) {
+            int j = cornerSlot(applySymmetry(s, CORNER_POSITIONS[i]));
+            cornerSlotMap[s][i] = j;
+            for(int k = 0; k < 3; k++) {
+                cornerFaceletMap[s][i][k] = faceletIndex(cornerFacelets[j], applySymmetry(s, cornerFacelets[i][k]));
+            }
+        }
+        for(int i = 0; i < EDGE_COUNT; i++) {
+            int j = edgeSlot(applySymmetry(s, EDGE_POSITIONS[i]));
+            edgeSlotMap[s][i] = j;
+            for(int k = 0; k < 2; k++) {
+                edgeFaceletMap[s][i][k] = faceletIndex(edgeFacelets[j], applySymmetry(s, edgeFacelets[i][k]));
+            }
+        }
+    }
+}
+
+static const Geometry& geometry()
+{
+    static const Geometry instance;
+    return instance;
+}
+
+std::string FormatMoves(const std::vector<int>& moves)
+{
+    static const char FACE_LETTERS[] = "FBLRUD";
+    static const char* SUFFIXES[] = { "", "2", "'" };
+
+    std::string text;
+    for(int move : moves) {
+        if(!text.empty()) { text += ' '; }
+        text += FACE_LETTERS[move / 3];
+        text += SUFFIXES[move % 3];
+    }
+    return text;
+}
+
+std::vector<int> InvertMoves(const std::vector<int>& moves)
+{
+    std::vector<int> inverse(moves.rbegin(), moves.rend());
+    for(int& move : inverse) {
+        move = move / 3 * 3 + (2 - move % 3);
+    }
+    return inverse;
+}
+
+//////////////////
+// PackedState //
+//////////////////
+
+// Finalizer of MurmurHash3
+static uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t PackedState::hash() const
+{
+    return mix64(lo ^ mix64(hi + 0x9e3779b97f4a7c15ull));
+}
+
+////////////////
+// CubeState //
+////////////////
+
+CubeState CubeState::solved()
+{
+    CubeState state;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        state.cp[i] = i;
+        state.co[i] = 0;
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        state.ep[i] = i;
+        state.eo[i] = 0;
+    }
+    return state;
+}
+
+const CubeState& CubeState::moveState(int move)
+{
+    return geometry().moves[move];
+}
+
+bool CubeState::fromCubies(const Cubie* cubes, CubeState& state)
+{
+    const Geometry& g = geometry();
+
+    // Whole cube rotations turn the core as well, everything is read relative to it
+    const Cubie* core = nullptr;
+    for(int i = 0; i < 27; i++) {
+        if(cubes[i].id == 13) { core = &cubes[i]; }
+    }
+    if(!core) { return false; }
+    glm::mat3 toCore = glm::transpose(glm::mat3(core->rotationMatrix));
+
+    auto snap = [](const glm::vec3& v, IVec3& out) {
+        glm::vec3 r = glm::round(v);
+        out = { (int)r.x, (int)r.y, (int)r.z };
+        return glm::all(glm::lessThan(glm::abs(v - r), glm::vec3(0.25f)));
+    };
+
+    bool cornerSeen[CORNER_COUNT] = {}, edgeSeen[EDGE_COUNT] = {};
+    for(int i = 0; i < 27; i++) {
+        int id = cubes[i].id;
+        IVec3 home = { id / 9 - 1, (id / 3) % 3 - 1, id % 3 - 1 };
+        int axes = (home.x != 0) + (home.y != 0) + (home.z != 0);
+        if(axes < 2) { continue; }
+
+        IVec3 position;
+        if(!snap(toCore * cubes[i].position / CUBIE_SCALE, position)) { return false; }
+        glm::mat3 rotation = toCore * glm::mat3(cubes[i].rotationMatrix);
+
+        if(axes == 3) {
+            int piece = cornerSlot(home), slot = cornerSlot(position);
+            IVec3 reference;
+            const IVec3& d = g.cornerFacelets[piece][0];
+            if(slot < 0 || cornerSeen[slot] || !snap(rotation * glm::vec3(d.x, d.y, d.z), reference)) { return false; }
+            int twist = faceletIndex(g.cornerFacelets[slot], reference);
+            if(twist < 0) { return false; }
+            cornerSeen[slot] = true;
+            state.cp[slot] = piece;
+            state.co[slot] = twist;
+        } else {
+            int piece = edgeSlot(home), slot = edgeSlot(position);
+            IVec3 reference;
+            const IVec3& d = g.edgeFacelets[piece][0];
+            if(slot < 0 || edgeSeen[slot] || !snap(rotation * glm::vec3(d.x, d.y, d.z), reference)) { return false; }
+            int flip = faceletIndex(g.edgeFacelets[slot], reference);
+            if(flip < 0) { return false; }
+            edgeSeen[slot] = true;
+            state.ep[slot] = piece;
+            state.eo[slot] = flip;
+        }
+    }
+    return true;
+}
+
+CubeState CubeState::multiply(const CubeState& other) const
+{
+    CubeState result;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        result.cp[i] = cp[other.cp[i]];
+        result.co[i] = (co[other.cp[i]] + other.co[i]) % 3;
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        result.ep[i] = ep[other.ep[i]];
+        result.eo[i] = eo[other.ep[i]] ^ other.eo[i];
+    }
+    return result;
+}
+
+CubeState CubeState::inverse() const
+{
+    CubeState result;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        result.cp[cp[i]] = i;
+        result.co[cp[i]] = (3 - co[i]) % 3;
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        result.ep[ep[i]] = i;
+        result.eo[ep[i]] = eo[i];
+    }
+    return result;
+}
+
+bool CubeState::isSolved() const
+{
+    return *this == solved();
+}
+
+template<int N>
+static int parity(const uint8_t (&permutation)[N])
+{
+    int inversions = 0;
+    for(int i = 0; i < N; i++) {
+        for(int j = i + 1; j < N; j++) {
+            inversions += permutation[i] > permutation[j];
+        }
+    }
+    return inversions & 1;
+}
+
+bool CubeState::isSolvable() const
+{
+    int twist = 0, flip = 0;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        twist += co[i];
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        flip += eo[i];
+    }
+    return twist % 3 == 0 && flip % 2 == 0 && parity(cp) == parity(ep);
+}
+
+bool CubeState::operator==(const CubeState& other) const
+{
+    return std::equal(cp, cp + CORNER_COUNT, other.cp) && std::equal(co, co + CORNER_COUNT, other.co)
+        && std::equal(ep, ep + EDGE_COUNT, other.ep) && std::equal(eo, eo + EDGE_COUNT, other.eo);
+}
+
+PackedState CubeState::pack() const
+{
+    PackedState packed = { 0, 0 };
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        packed.lo |= (uint64_t)cp[i] << (3 * i);
+        packed.lo |= (uint64_t)co[i] << (24 + 2 * i);
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        packed.lo |= (uint64_t)eo[i] << (40 + i);
+        packed.hi |= (uint64_t)ep[i] << (4 * i);
+    }
+    return packed;
+}
+
+CubeState CubeState::unpack(const PackedState& packed)
+{
+    CubeState state;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        state.cp[i] = (packed.lo >> (3 * i)) & 0x7;
+        state.co[i] = (packed.lo >> (24 + 2 * i)) & 0x3;
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        state.eo[i] = (packed.lo >> (40 + i)) & 0x1;
+        state.ep[i] = (packed.hi >> (4 * i)) & 0xF;
+    }
+    return state;
+}
+
+CubeState CubeState::conjugate(int symmetry) const
+{
+    const Geometry& g = geometry();
+    const uint8_t (*cornerFacelets)[3] = g.cornerFaceletMap[symmetry];
+    const uint8_t (*edgeFacelets)[2] = g.edgeFaceletMap[symmetry];
+
+    /*
+    Relabel everything through the symmetry: the piece in slot i goes to slot s(i) and becomes piece s(p).
+    Its new reference facelet is the image of the facelet j of p that maps to facelet 0 of s(p), which sits on
+    facelet (twist + j) of slot i. Mirrors reverse the facelet order, so this is done on facelets, not twists.
+    */
+    CubeState result;
+    for(int i = 0; i < CORNER_COUNT; i++) {
+        int piece = cp[i];
+        int j = cornerFacelets[piece][0] == 0 ? 0 : (cornerFacelets[piece][1] == 0 ? 1 : 2);
+        int slot = g.cornerSlotMap[symmetry][i];
+        result.cp[slot] = g.cornerSlotMap[symmetry][piece];
+        result.co[slot] = cornerFacelets[i][(co[i] + j) % 3];
+    }
+    for(int i = 0; i < EDGE_COUNT; i++) {
+        int piece = ep[i];
+        int j = edgeFacelets[piece][0] == 0 ? 0 : 1;
+        int slot = g.edgeSlotMap[symmetry][i];
+        result.ep[slot] = g.edgeSlotMap[symmetry][piece];
+        result.eo[slot] = edgeFacelets[i][eo[i] ^ j];
+    }
+    return result;
+}
+
+PackedState CubeState::canonical(int* symmetry) const
+{
+    PackedState best = pack();
+    int bestSymmetry = 0;
+    for(int s = 1; s < SYMMETRY_COUNT; s++) {
+        PackedState candidate = conjugate(s).pack();
+        if(candidate < best) {
+            best = candidate;
+            bestSymmetry = s;
+        }
+    }
+    if(symmetry) { *symmetry = bestSymmetry; }
+    return best;
+}
+
+/////////////////////////
+// TranspositionTable //
+/////////////////////////
+
+// co never holds 3, so this key can't be a real state
+static const PackedState EMPTY_KEY = { ~0ull, ~0ull };
+
+TranspositionTable::TranspositionTable(size_t capacity)
+{
+    size_t size = 16;
+    while(size < capacity) {
+        size <<= 1;
+    }
+    m_Entries.assign(size, { EMPTY_KEY, 0 });
+    m_Mask = size - 1;
+}
+
+bool TranspositionTable::insert(const PackedState& key, uint32_t value)
+{
+    // Linear probing, the table is never resized
+    for(uint64_t i = key.hash() & m_Mask, probes = 0; probes < m_Entries.size(); i = (i + 1) & m_Mask, probes++) {
+        Entry& entry = m_Entries[i];
+        if(entry.key == key) {
+            entry.value = value;
+            return true;
+        }
+        if(entry.key == EMPTY_KEY) {
+            entry.key = key;
+            entry.value = value;
+            m_Size++;
+            return true;
+        }
+    }
+    return false;
+}
+
+const uint32_t* TranspositionTable::find(const PackedState& key) const
+{
+    for(uint64_t i = key.hash() & m_Mask, probes = 0; probes < m_Entries.size(); i = (i + 1) & m_Mask, probes++) {
+        const Entry& entry = m_Entries[i];
+        if(entry.key == key) { return &entry.value; }
+        if(entry.key == EMPTY_KEY) { return nullptr; }
+    }
+    return nullptr;
+}
+
+void TranspositionTable::clear()
+{
+    std::fill(m_Entries.begin(), m_Entries.end(), Entry{ EMPTY_KEY, 0 });
+    m_Size = 0;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "RubiksCube.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static constexpr int CORNER_COUNT = 8;
+static constexpr int EDGE_COUNT = 12;
+
+// Face turns: move = face * 3 + (quarterTurns - 1), faces in RubiksCube::rotateFace order, clockwise seen from the face
+static constexpr int MOVE_COUNT = 18;
+static constexpr int SYMMETRY_COUNT = 48;
+
+// Moves in face letters, e.g. "R U2 F'"
+std::string FormatMoves(const std::vector<int>& moves);
+
+// The moves undoing a sequence: reversed, each turned the other way
+std::vector<int> InvertMoves(const std::vector<int>& moves);
+
+// 16 byte encoding of a CubeState, equal states have equal encodings
+struct PackedState
+{
+    // cp (8 x 3 bits) | co (8 x 2 bits) << 24 | eo (12 x 1 bit) << 40
+    uint64_t lo;
+    // ep (12 x 4 bits)
+    uint64_t hi;
+
+    bool operator==(const PackedState& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const PackedState& other) const { return !(*this == other); }
+    bool operator<(const PackedState& other) const { return hi != other.hi ? hi < other.hi : lo < other.lo; }
+
+    // 64-bit hash with good avalanche, suitable for power-of-two tables
+    uint64_t hash() const;
+};
+
+struct PackedStateHasher
+{
+    size_t operator()(const PackedState& state) const { return (size_t)state.hash(); }
+};
+
+/*
+Integer cubie model of a 3x3 cube, relative to the centers.
+Slot i holds the piece cp[i] (the piece whose solved slot is cp[i]) twisted by co[i] (corners, 0..2)
+or flipped by eo[i] (edges, 0..1).
+*/
+struct CubeState
+{
+    uint8_t cp[CORNER_COUNT];
+    uint8_t co[CORNER_COUNT];
+    uint8_t ep[EDGE_COUNT];
+    uint8_t eo[EDGE_COUNT];
+
+    static CubeState solved();
+
+    // The state of a face turn applied to the solved cube
+    static const CubeState& moveState(int move);
+
+    // Read the arrangement of RubiksCube's cubies, false if cubies were dragged off the grid
+    static bool fromCubies(const Cubie* cubes, CubeState& state);
+
+    // This state followed by `other`
+    CubeState multiply(const CubeState& other) const;
+    CubeState inverse() const;
+
+    void applyMove(int move) { *this = multiply(moveState(move)); }
+
+    bool isSolved() const;
+    // Permutation parities match and orientations sum to zero
+    bool isSolvable() const;
+
+    bool operator==(const CubeState& other) const;
+    bool operator!=(const CubeState& other) const { return !(*this == other); }
+
+    PackedState pack() const;
+    static CubeState unpack(const PackedState& packed);
+
+    uint64_t hash() const { return pack().hash(); }
+
+    // The state seen through one of the 48 symmetries of the cube (24 rotations, each optionally mirrored)
+    CubeState conjugate(int symmetry) const;
+
+    // Smallest encoding among the 48 symmetric states, `symmetry` receives the one that produced it
+    PackedState canonical(int* symmetry = nullptr) const;
+};
+
+// Fixed capacity open addressing set of packed states with a value each, for deduplication during search
+class TranspositionTable
+{
+    private:
+        struct Entry
+        {
+            PackedState key;
+            uint32_t value;
+        };
+
+        std::vector<Entry> m_Entries;
+        uint64_t m_Mask;
+        size_t m_Size = 0;
+
+    public:
+        // Capacity is rounded up to a power of two, keep the load under ~70%
+        TranspositionTable(size_t capacity);
+
+        // Insert or overwrite, false when the table is full
+        bool insert(const PackedState& key, uint32_t value);
+        // Pointer to the stored value or nullptr
+        const uint32_t* find(const PackedState& key) const;
+
+        void clear();
+        size_t size() const { return m_Size; }
+        size_t capacity() const { return m_Entries.size(); }
+};
@@ -0,0 +1,59 @@
+#include <DepthSort.h>
+
+#include <cstring>
+
+static constexpr int RADIX_BITS = DEPTH_SORT_KEY_BITS / 2;
+static constexpr uint32_t RADIX = 1u << RADIX_BITS;
+
+void DepthSort::reserve(size_t count)
+{
+    m_Entries[0].reserve(count);
+    m_Entries[1].reserve(count);
+    m_Order.reserve(count);
+}
+
+const std::vector<uint32_t>& DepthSort::sort(const glm::mat4* models, size_t count, const glm::mat4& view)
+{
+    m_Entries[0].resize(count);
+    m_Entries[1].resize(count);
+    m_Order.resize(count);
+
+    /* Keys from the view depth of the centers, only the z row of the view matrix is needed */
+    glm::vec4 row(view[0][2], view[1][2], view[2][2], view[3][2]);
+    uint32_t histograms[2][RADIX] = {};
+    uint64_t* entries = m_Entries[0].data();
+    for(size_t i = 0; i < count; i++) {
+        float depth = -glm::dot(row, models[i][3]);
+        uint32_t bits;
+        memcpy(&bits, &depth, sizeof(bits));
+        // Ascending order of the flipped bits is descending order of the depths
+        uint32_t key = (bits & 0x80000000u ? bits : ~bits & 0x7fffffffu) >> (32 - DEPTH_SORT_KEY_BITS);
+        entries[i] = (uint64_t)key << 32 | (uint32_t)i;
+        histograms[0][key & (RADIX - 1)]++;
+        histograms[1][key >> RADIX_BITS]++;
+    }
+
+    /* Two scatter passes, low digit then high digit, each stable so the high one keeps the low order */
+    for(int pass = 0; pass < 2; pass++) {
+        uint32_t offset = 0;
+        for(uint32_t digit = 0; digit < RADIX; digit++) {
+            uint32_t bucket = histograms[pass][digit];
+            histograms[pass][digit] = offset;
+            offset += bucket;
+        }
+    }
+
+    const uint64_t* from = m_Entries[0].data();
+    uint64_t* to = m_Entries[1].data();
+    for(size_t i = 0; i < count; i++) {
+        uint64_t entry = from[i];
+        to[histograms[0][(entry >> 32) & (RADIX - 1)]++] = entry;
+    }
+    // The last pass only keeps the indices
+    uint32_t* order = m_Order.data();
+    for(size_t i = 0; i < count; i++) {
+        uint64_t entry = to[i];
+        order[histograms[1][entry >> (32 + RADIX_BITS)]++] = (uint32_t)entry;
+    }
+    return m_Order;
+}
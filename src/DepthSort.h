@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Bits of the depth keys, sorted in two passes of half of them
+static constexpr int DEPTH_SORT_KEY_BITS = 22;
+
+/*
+Back-to-front order of objects by the view depth of their center, for blending them without order-independent
+transparency. The keys are the top DEPTH_SORT_KEY_BITS of the float depths, with the bits flipped so that unsigned
+keys order like the depths and the farthest comes first: no range pass is needed and depths closer than a relative
+2^-13 share a key. They are sorted with a stable LSD radix sort, two passes of 11 bits whose histograms fit in L1.
+The buffers only grow, so sorting the same number of objects every frame never allocates.
+*/
+class DepthSort
+{
+    private:
+        // Key in the high half and index in the low half, so a pass moves a single array
+        std::vector<uint64_t> m_Entries[2];
+        std::vector<uint32_t> m_Order;
+
+    public:
+        // Allocate the buffers for `count` objects up front
+        void reserve(size_t count);
+
+        // Indices of `models` from the farthest to the closest seen from `view`, ties keep their order
+        const std::vector<uint32_t>& sort(const glm::mat4* models, size_t count, const glm::mat4& view);
+};
@@ -0,0 +1,214 @@
+#include <Facelets.h>
+
+#include <numeric>
+
+struct Vec
+{
+    int v[3];
+
+    bool operator==(const Vec& other) const { return v[0] == other.v[0] && v[1] == other.v[1] && v[2] == other.v[2]; }
+};
+
+// Outward normal, then the right and down directions of the face seen from outside
+static const Vec FACE_FRAMES[6][3] = {
+    { { 0, 0, 1 }, { 1, 0, 0 }, { 0, -1, 0 } },     // F
+    { { 0, 0, -1 }, { -1, 0, 0 }, { 0, -1, 0 } },   // B
+    { { -1, 0, 0 }, { 0, 0, 1 }, { 0, -1, 0 } },    // L
+    { { 1, 0, 0 }, { 0, 0, -1 }, { 0, -1, 0 } },    // R
+    { { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },      // U
+    { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } }     // D
+};
+
+// Clockwise quarter turn around a positive axis, seen from the positive side
+static Vec turn(const Vec& a, int axis)
+{
+    int b = (axis + 1) % 3, c = (axis + 2) % 3;
+    Vec result = a;
+    result.v[b] = a.v[c];
+    result.v[c] = -a.v[b];
+    return result;
+}
+
+struct TurnTables
+{
+    Vec positions[FACELET_COUNT];
+    Vec normals[FACELET_COUNT];
+    // [axis][layers][quarters], quarters 0 and layers 0 are the identity
+    FaceletPermutation turns[AXIS_COUNT][8][4];
+
+    TurnTables()
+    {
+        for(int face = 0; face < 6; face++) {
+            for(int i = 0; i < 9; i++) {
+                const Vec* frame = FACE_FRAMES[face];
+                for(int k = 0; k < 3; k++) {
+                    positions[face * 9 + i].v[k] = frame[0].v[k] + (i % 3 - 1) * frame[1].v[k] + (i / 3 - 1) * frame[2].v[k];
+                }
+                normals[face * 9 + i] = frame[0];
+            }
+        }
+
+        for(int axis = 0; axis < AXIS_COUNT; axis++) {
+            for(int layers = 0; layers < 8; layers++) {
+                FaceletPermutation quarter = FaceletPermutation::identity();
+                for(int i = 0; i < FACELET_COUNT; i++) {
+                    if(!(layers & (1 << (positions[i].v[axis] + 1)))) { continue; }
+                    quarter.to[i] = find(turn(positions[i], axis), turn(normals[i], axis));
+                }
+
+                turns[axis][layers][0] = FaceletPermutation::identity();
+                for(int quarters = 1; quarters < 4; quarters++) {
+                    turns[axis][layers][quarters] = turns[axis][layers][quarters - 1].multiply(quarter);
+                }
+            }
+        }
+    }
+
+    uint8_t find(const Vec& position, const Vec& normal) const
+    {
+        for(int i = 0; i < FACELET_COUNT; i++) {
+            if(positions[i] == position && normals[i] == normal) { return (uint8_t)i; }
+        }
+        return 0;
+    }
+};
+
+static const TurnTables& tables()
+{
+    static TurnTables instance;
+    return instance;
+}
+
+FaceletPermutation FaceletPermutation::identity()
+{
+    FaceletPermutation result;
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        result.to[i] = (uint8_t)i;
+    }
+    return result;
+}
+
+const FaceletPermutation& FaceletPermutation::fromTurn(const LayerTurn& turn)
+{
+    return tables().turns[turn.axis % AXIS_COUNT][turn.layers & 7][turn.quarters & 3];
+}
+
+FaceletPermutation FaceletPermutation::multiply(const FaceletPermutation& other) const
+{
+    FaceletPermutation result;
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        result.to[i] = other.to[to[i]];
+    }
+    return result;
+}
+
+FaceletPermutation FaceletPermutation::inverse() const
+{
+    FaceletPermutation result;
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        result.to[to[i]] = (uint8_t)i;
+    }
+    return result;
+}
+
+FaceletPermutation FaceletPermutation::power(long long n) const
+{
+    FaceletPermutation result = identity();
+    for(const std::vector<uint8_t>& cycle : cycles()) {
+        long long length = (long long)cycle.size();
+        long long shift = (n % length + length) % length;
+        for(long long k = 0; k < length; k++) {
+            result.to[cycle[k]] = cycle[(k + shift) % length];
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<uint8_t>> FaceletPermutation::cycles() const
+{
+    std::vector<std::vector<uint8_t>> result;
+    bool seen[FACELET_COUNT] = {};
+    for(int start = 0; start < FACELET_COUNT; start++) {
+        if(seen[start] || to[start] == start) { continue; }
+
+        std::vector<uint8_t> cycle;
+        for(int i = start; !seen[i]; i = to[i]) {
+            seen[i] = true;
+            cycle.push_back((uint8_t)i);
+        }
+        result.push_back(cycle);
+    }
+    return result;
+}
+
+uint64_t FaceletPermutation::order() const
+{
+    uint64_t order = 1;
+    for(const std::vector<uint8_t>& cycle : cycles()) {
+        order = std::lcm(order, (uint64_t)cycle.size());
+    }
+    return order;
+}
+
+std::vector<PieceCycle> FaceletPermutation::pieceCycles() const
+{
+    static const int CUBIE_COUNT = 27;
+
+    int cubieTo[CUBIE_COUNT];
+    for(int cubie = 0; cubie < CUBIE_COUNT; cubie++) {
+        cubieTo[cubie] = cubie;
+    }
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        cubieTo[FaceletCubie(i)] = FaceletCubie(to[i]);
+    }
+
+    std::vector<PieceCycle> result;
+    bool seen[CUBIE_COUNT] = {};
+    for(int start = 0; start < CUBIE_COUNT; start++) {
+        if(seen[start]) { continue; }
+
+        PieceCycle cycle;
+        for(int cubie = start; !seen[cubie]; cubie = cubieTo[cubie]) {
+            seen[cubie] = true;
+            cycle.cubies.push_back(cubie);
+        }
+
+        FaceletPermutation around = power((long long)cycle.cubies.size());
+        cycle.reoriented = false;
+        for(int i = 0; i < FACELET_COUNT; i++) {
+            if(FaceletCubie(i) == start && around.to[i] != i) { cycle.reoriented = true; }
+        }
+        if(cycle.cubies.size() > 1 || cycle.reoriented) { result.push_back(cycle); }
+    }
+    return result;
+}
+
+bool FaceletPermutation::isIdentity() const
+{
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        if(to[i] != i) { return false; }
+    }
+    return true;
+}
+
+void FaceletPermutation::apply(const uint8_t* facelets, uint8_t* result) const
+{
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        result[to[i]] = facelets[i];
+    }
+}
+
+std::array<uint8_t, FACELET_COUNT> SolvedFacelets()
+{
+    std::array<uint8_t, FACELET_COUNT> facelets;
+    for(int i = 0; i < FACELET_COUNT; i++) {
+        facelets[i] = (uint8_t)(i / 9);
+    }
+    return facelets;
+}
+
+int FaceletCubie(int facelet)
+{
+    const int* position = tables().positions[facelet].v;
+    return (position[0] + 1) * 9 + (position[1] + 1) * 3 + (position[2] + 1);
+}
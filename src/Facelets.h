@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// 6 faces of 9 stickers, face * 9 + row * 3 + column, faces in RubiksCube::rotateFace order
+static constexpr int FACELET_COUNT = 54;
+
+// Axes of the cube: 0 x (right), 1 y (up), 2 z (front)
+static constexpr int AXIS_COUNT = 3;
+
+/*
+Quarter turns of some of the three layers perpendicular to an axis. Layer i holds the cubies at coordinate i - 1
+on the axis, so layer 2 is the R, U or F face. Turns are clockwise seen from the positive side of the axis.
+*/
+struct LayerTurn
+{
+    uint8_t axis;
+    uint8_t layers;     // bit mask of the turned layers
+    uint8_t quarters;   // 1..3
+};
+
+// Cubies visiting each other's places, in RubiksCube's cubes indexing (see FaceletCubie)
+struct PieceCycle
+{
+    std::vector<int> cubies;
+    // Some sticker isn't back in place after going once around the cycle: the pieces are twisted or flipped
+    bool reoriented;
+};
+
+/*
+Permutation of the 54 stickers of the whole puzzle, centers included, so that slices and cube rotations compose
+like face turns. to[i] is where the sticker at i goes.
+*/
+struct FaceletPermutation
+{
+    std::array<uint8_t, FACELET_COUNT> to;
+
+    static FaceletPermutation identity();
+    static const FaceletPermutation& fromTurn(const LayerTurn& turn);
+
+    // This permutation followed by `other`
+    FaceletPermutation multiply(const FaceletPermutation& other) const;
+
+    FaceletPermutation inverse() const;
+    // Applied n times (negative for the inverse), through the cycles: every sticker moves n mod its cycle length
+    FaceletPermutation power(long long n) const;
+
+    // Cycles longer than 1, each starting at its smallest sticker
+    std::vector<std::vector<uint8_t>> cycles() const;
+    // Applications until the cube is back to its start, the lcm of the cycle lengths
+    uint64_t order() const;
+    // The moved or reoriented cubies, a cubie reoriented in place being a cycle of 1
+    std::vector<PieceCycle> pieceCycles() const;
+
+    bool isIdentity() const;
+
+    // Move the stickers of a colored cube, e.g. face indices from SolvedFacelets()
+    void apply(const uint8_t* facelets, uint8_t* result) const;
+
+    bool operator==(const FaceletPermutation& other) const { return to == other.to; }
+    bool operator!=(const FaceletPermutation& other) const { return to != other.to; }
+};
+
+// The face of every sticker of the solved cube
+std::array<uint8_t, FACELET_COUNT> SolvedFacelets();
+
+// Cubie a sticker belongs to, indexed like RubiksCube's cubes: (x + 1) * 9 + (y + 1) * 3 + (z + 1)
+int FaceletCubie(int facelet);
@@ -0,0 +1,54 @@
+#include <FrameArena.h>
+
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena()
+    : m_Buffer(new unsigned char[FRAME_ARENA_INITIAL_SIZE]), m_Capacity(FRAME_ARENA_INITIAL_SIZE)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    uintptr_t base = (uintptr_t)m_Buffer.get();
+    size_t offset = ((base + m_Used + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    m_Requested += size + alignment - 1;
+    if(offset + size <= m_Capacity) {
+        m_Used = offset + size;
+        return m_Buffer.get() + offset;
+    }
+
+    // Doesn't fit this frame: a heap block, with the link to the previous one in front of the data
+    size_t header = std::max(sizeof(void*), alignment);
+    unsigned char* block = (unsigned char*)::operator new(header + size + alignment);
+    *(void**)block = m_Overflow;
+    m_Overflow = block;
+    uintptr_t data = ((uintptr_t)block + header + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return (void*)data;
+}
+
+void FrameArena::releaseOverflow()
+{
+    while(m_Overflow) {
+        void* next = *(void**)m_Overflow;
+        ::operator delete(m_Overflow);
+        m_Overflow = next;
+    }
+}
+
+void FrameArena::reset()
+{
+    m_HighWater = std::max(m_HighWater, m_Requested);
+    if(m_Overflow) {
+        releaseOverflow();
+        m_Capacity = m_HighWater;
+        m_Buffer.reset(new unsigned char[m_Capacity]);
+    }
+    m_Used = 0;
+    m_Requested = 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Size of the arena before any frame needed more
+static constexpr size_t FRAME_ARENA_INITIAL_SIZE = 256 * 1024;
+
+/*
+Linear allocator for data that only lives until the end of the frame, e.g. instance data gathered for a draw.
+Allocating moves a pointer and nothing is freed until reset() at the start of the next frame. A frame needing more
+than the capacity gets blocks from the heap, and the next reset() grows the arena to what that frame used, so the
+steady state doesn't allocate. Only for trivially destructible types, no destructor is ever called.
+*/
+class FrameArena
+{
+    private:
+        std::unique_ptr<unsigned char[]> m_Buffer;
+        size_t m_Capacity = 0;
+        size_t m_Used = 0;
+        // Bytes asked for this frame, including those that went to the heap
+        size_t m_Requested = 0;
+        size_t m_HighWater = 0;
+
+        // Heap blocks of this frame, linked through their first bytes
+        void* m_Overflow = nullptr;
+
+        FrameArena();
+        void releaseOverflow();
+
+    public:
+        static FrameArena &getInstance() {
+            static FrameArena instance;
+            return instance;
+        }
+        ~FrameArena();
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        T* allocate(size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Frame arena data is never destroyed");
+            return (T*)allocate(count * sizeof(T), alignof(T));
+        }
+
+        // Release everything allocated since the last reset
+        void reset();
+
+        size_t getCapacity() const { return m_Capacity; }
+        // Most bytes a frame asked for
+        size_t getHighWater() const { return m_HighWater; }
+};
@@ -0,0 +1,129 @@
+#include <FrameBuffer.h>
+#include <RenderState.h>
+
+#include <iostream>
+
+FrameBuffer::FrameBuffer(int width, int height, int samples, unsigned int format)
+    : m_Width(width), m_Height(height), m_Samples(samples > 1 ? samples : 1), m_Format(format)
+{
+    create();
+}
+
+FrameBuffer::~FrameBuffer()
+{
+    destroy();
+}
+
+void FrameBuffer::create()
+{
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+
+    if(m_Samples > 1) {
+        GLCall(glGenRenderbuffers(1, &m_Color));
+        GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_Color));
+        GLCall(glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_Samples, m_Format, m_Width, m_Height));
+        GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Color));
+    } else {
+        // Filtered, post-processing passes sample between texels
+        GLCall(glGenTextures(1, &m_Color));
+        RenderState::getInstance().bindTexture(0, m_Color);
+        GLCall(glTexImage2D(GL_TEXTURE_2D, 0, m_Format, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_Color, 0));
+        RenderState::getInstance().bindTexture(0, 0);
+    }
+
+    if(m_Samples > 1) {
+        GLCall(glGenRenderbuffers(1, &m_Depth));
+        GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_Depth));
+        GLCall(glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_Samples, GL_DEPTH_COMPONENT24, m_Width, m_Height));
+        GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_Depth));
+        GLCall(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    } else {
+        // Depth values aren't interpolated, e.g. for screen-space ambient occlusion
+        GLCall(glGenTextures(1, &m_Depth));
+        RenderState::getInstance().bindTexture(0, m_Depth);
+        GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, m_Width, m_Height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_Depth, 0));
+        RenderState::getInstance().bindTexture(0, 0);
+    }
+
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if(status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Warning: framebuffer " << m_Width << "x" << m_Height << " with " << m_Samples
+            << " sample(s) is incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void FrameBuffer::destroy()
+{
+    if(m_Samples > 1) {
+        GLCall(glDeleteRenderbuffers(1, &m_Color));
+        GLCall(glDeleteRenderbuffers(1, &m_Depth));
+    } else {
+        RenderState::getInstance().forget(RenderBinding::Texture, m_Color);
+        RenderState::getInstance().forget(RenderBinding::Texture, m_Depth);
+        GLCall(glDeleteTextures(1, &m_Color));
+        GLCall(glDeleteTextures(1, &m_Depth));
+    }
+    GLCall(glDeleteFramebuffers(1, &m_RendererID));
+}
+
+void FrameBuffer::Resize(int width, int height)
+{
+    if(width == m_Width && height == m_Height) { return; }
+    if(width <= 0 || height <= 0) { return; }
+
+    destroy();
+    m_Width = width;
+    m_Height = height;
+    create();
+}
+
+void FrameBuffer::Bind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+}
+
+void FrameBuffer::Unbind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void FrameBuffer::Resolve(const FrameBuffer* target, bool depth) const
+{
+    // Depth can only be blitted with nearest filtering, multisampled color is averaged whatever the filter
+    GLbitfield mask = GL_COLOR_BUFFER_BIT | (depth ? GL_DEPTH_BUFFER_BIT : 0);
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID));
+    GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target ? target->m_RendererID : 0));
+    GLCall(glBlitFramebuffer(0, 0, m_Width, m_Height, 0, 0, m_Width, m_Height, mask, GL_NEAREST));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void FrameBuffer::BindTexture(unsigned int slot) const
+{
+    ASSERT(m_Samples == 1);
+    RenderState::getInstance().bindTexture(slot, m_Color);
+}
+
+void FrameBuffer::BindDepthTexture(unsigned int slot) const
+{
+    ASSERT(m_Samples == 1);
+    RenderState::getInstance().bindTexture(slot, m_Depth);
+}
+
+int FrameBuffer::GetMaxSamples()
+{
+    int samples = 1;
+    GLCall(glGetIntegerv(GL_MAX_SAMPLES, &samples));
+    return samples;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Debugger.h>
+
+/*
+FBO with a color and a depth attachment. Multisampled buffers render into renderbuffers and are resolved with
+a blit, single-sampled ones into textures that later passes can sample.
+*/
+class FrameBuffer
+{
+    private:
+        unsigned int m_RendererID = 0;
+        unsigned int m_Color = 0;       // renderbuffers when multisampled, textures otherwise
+        unsigned int m_Depth = 0;
+        int m_Width = 0;
+        int m_Height = 0;
+        int m_Samples;
+        unsigned int m_Format;
+
+        void create();
+        void destroy();
+
+    public:
+        // `format` is the internal format of the color, e.g. GL_RG16F for a pass storing two values per pixel
+        FrameBuffer(int width, int height, int samples = 1, unsigned int format = GL_RGBA8);
+        ~FrameBuffer();
+
+        // Reallocate the attachments when the size changed, their content is lost
+        void Resize(int width, int height);
+
+        // Draw into the buffer, Unbind draws into the window again
+        void Bind() const;
+        void Unbind() const;
+
+        // Copy the color to `target`, or to the window when null, averaging the samples of multisampled buffers.
+        // The depth is copied too when asked, from one of the samples
+        void Resolve(const FrameBuffer* target, bool depth = false) const;
+
+        // Sample the color or the depth texture of a single-sampled buffer
+        void BindTexture(unsigned int slot = 0) const;
+        void BindDepthTexture(unsigned int slot) const;
+
+        inline int GetWidth() const { return m_Width; }
+        inline int GetHeight() const { return m_Height; }
+        inline int GetSamples() const { return m_Samples; }
+
+        // Most samples supported by the driver
+        static int GetMaxSamples();
+};
@@ -0,0 +1,98 @@
+#include <FrameScheduler.h>
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Left between the end of the estimated rendering and the refresh, absorbs the variance of frames
+static const double POLL_MARGIN = 0.0015;
+// Weight of the last frame in the estimate of the render time
+static const double RENDER_SMOOTHING = 0.1;
+
+void FrameScheduler::setSwapInterval(int interval)
+{
+    if(interval == SWAP_INTERVAL_ADAPTIVE
+        && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+        printf("Adaptive vsync isn't supported, using vsync\n");
+        interval = 1;
+    }
+    m_SwapInterval = interval;
+    glfwSwapInterval(interval);
+
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    m_RefreshPeriod = mode && mode->refreshRate > 0 ? 1.0 / mode->refreshRate : 0.0;
+}
+
+void FrameScheduler::beginFrame()
+{
+    Clock::time_point now = Clock::now();
+    m_FrameTime = m_Started ? std::chrono::duration<double>(now - m_LastFrame).count() : 0.0;
+    m_LastFrame = now;
+    m_Started = true;
+
+    m_Accumulator += m_FrameTime;
+    m_Steps = std::min((int)(m_Accumulator * SIMULATION_RATE), MAX_STEPS_PER_FRAME);
+    m_Accumulator = std::min(m_Accumulator - m_Steps * getStep(), getStep());
+}
+
+void FrameScheduler::pollInput()
+{
+    // Synchronized swaps: the frame is shown at the refresh after the last one, no need to poll earlier
+    if(m_SwapInterval != 0 && m_RefreshPeriod > 0.0 && m_LastSwap != Clock::time_point()) {
+        double budget = std::abs(m_SwapInterval) * m_RefreshPeriod - m_RenderEstimate - POLL_MARGIN;
+        Clock::time_point deadline = m_LastSwap + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(budget));
+        if(deadline > Clock::now()) { std::this_thread::sleep_until(deadline); }
+    }
+
+    // Input that ended waitInput was polled then, its latency counts from there
+    bool woken = m_WokenByInput;
+    m_WokenByInput = false;
+    m_InputPending = false;
+    if(!woken) { m_PollTime = Clock::now(); }
+    glfwPollEvents();
+    m_FrameHasInput = woken || m_InputPending;
+}
+
+void FrameScheduler::waitInput(double timeout)
+{
+    m_InputPending = false;
+    glfwWaitEventsTimeout(timeout);
+    m_PollTime = Clock::now();
+    m_WokenByInput = m_InputPending;
+
+    m_Started = false;
+    m_Accumulator = 0.0;
+}
+
+void FrameScheduler::beforeSwap()
+{
+    m_SwapTime = Clock::now();
+    double render = std::chrono::duration<double>(m_SwapTime - m_PollTime).count();
+    m_RenderEstimate += RENDER_SMOOTHING * (render - m_RenderEstimate);
+}
+
+void FrameScheduler::afterSwap()
+{
+    m_LastSwap = Clock::now();
+    if(m_FrameHasInput) {
+        m_Latencies[m_LatencyCount % LATENCY_HISTORY] = std::chrono::duration<double>(m_LastSwap - m_PollTime).count();
+        m_LatencyCount++;
+    }
+}
+
+void FrameScheduler::printReport() const
+{
+    if(m_LatencyCount == 0) { return; }
+
+    size_t count = (size_t)std::min<unsigned long long>(m_LatencyCount, LATENCY_HISTORY);
+    std::vector<double> sorted(m_Latencies.begin(), m_Latencies.begin() + count);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) { return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))] * 1000.0; };
+    printf("Input latency (poll to swap) over the last %zu of %llu frames: p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms, swap interval %d\n",
+        count, m_LatencyCount, percentile(0.5), percentile(0.9), percentile(0.99), sorted.back() * 1000.0, m_SwapInterval);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+// Simulation steps per second, independent of the frame rate
+static constexpr double SIMULATION_RATE = 120.0;
+// Steps run by one frame at most, so a stall slows the simulation down instead of freezing the next frames
+static constexpr int MAX_STEPS_PER_FRAME = 8;
+// Frames with input whose latency is kept for the report, older ones are overwritten
+static constexpr int LATENCY_HISTORY = 4096;
+// Swap interval of adaptive vsync: synchronized, unless a frame is late (EXT_swap_control_tear)
+static constexpr int SWAP_INTERVAL_ADAPTIVE = -1;
+
+/*
+Paces the main loop: a fixed-timestep simulation with the rendering interpolated between its last two steps, and
+input polled as late as possible before the frame is drawn. With vsync, polling waits until just enough time is
+left to render before the next refresh, estimated from the last frames, so input is at most that old on screen.
+
+Frame:  beginFrame, simulate getStepCount() steps, pollInput, draw with getAlpha(), beforeSwap, swap, afterSwap
+
+When nothing changed the frame isn't drawn and the loop blocks in waitInput until the next event.
+*/
+class FrameScheduler
+{
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point m_LastFrame;
+        bool m_Started = false;
+        double m_Accumulator = 0.0;
+        double m_FrameTime = 0.0;
+        int m_Steps = 0;
+
+        int m_SwapInterval = 1;
+        double m_RefreshPeriod = 0.0;   // seconds, 0 when unknown
+
+        // Time from polling input to submitting the frame, smoothed
+        double m_RenderEstimate = 0.004;
+        Clock::time_point m_PollTime;
+        Clock::time_point m_SwapTime;
+        Clock::time_point m_LastSwap;
+        bool m_InputPending = false;
+        bool m_FrameHasInput = false;
+        bool m_WokenByInput = false;
+
+        // Seconds from polling an input to the end of the swap showing it, ring buffer of the last frames with input
+        std::array<double, LATENCY_HISTORY> m_Latencies;
+        unsigned long long m_LatencyCount = 0;
+
+        FrameScheduler() {};
+
+    public:
+        static FrameScheduler &getInstance() {
+            static FrameScheduler instance;
+            return instance;
+        }
+
+        // 0: off, n: every n-th refresh, SWAP_INTERVAL_ADAPTIVE (falls back to 1 where unsupported).
+        // Needs the OpenGL context to be current.
+        void setSwapInterval(int interval);
+        int getSwapInterval() const { return m_SwapInterval; }
+
+        void beginFrame();
+        int getStepCount() const { return m_Steps; }
+        static double getStep() { return 1.0 / SIMULATION_RATE; }
+        // Position of the frame between the last two steps, for interpolation
+        float getAlpha() const { return (float)(m_Accumulator * SIMULATION_RATE); }
+        // Seconds since the previous frame
+        float getFrameTime() const { return (float)m_FrameTime; }
+
+        // Wait for the latest moment to poll input, then poll it (glfwPollEvents)
+        void pollInput();
+        // Block until an event arrives or `timeout` seconds pass (glfwWaitEventsTimeout), before beginFrame. The
+        // time spent waiting isn't simulated.
+        void waitInput(double timeout);
+        // Called by the input callbacks
+        void onInput() { m_InputPending = true; }
+
+        void beforeSwap();
+        void afterSwap();
+
+        // Percentiles of the input latency over the last LATENCY_HISTORY frames with input
+        void printReport() const;
+};
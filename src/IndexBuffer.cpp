@@ -1,26 +1,91 @@
 #include <IndexBuffer.h>
+#include <RenderState.h>
 
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int size)
-    : m_Count(size / sizeof(unsigned int))
+#include <algorithm>
+#include <vector>
+
+unsigned int IndexTypeFor(unsigned int maxIndex)
+{
+    if(maxIndex < 0xFF) { return GL_UNSIGNED_BYTE; }
+    if(maxIndex < 0xFFFF) { return GL_UNSIGNED_SHORT; }
+    return GL_UNSIGNED_INT;
+}
+
+static unsigned int sizeOfIndex(unsigned int type)
+{
+    return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+}
+
+// Narrowed copy of the indices, restarts become the largest value of the type
+template<typename T>
+static std::vector<T> narrowIndices(const unsigned int* data, unsigned int count)
+{
+    std::vector<T> narrowed(count);
+    for(unsigned int i = 0; i < count; i++) {
+        narrowed[i] = data[i] == PRIMITIVE_RESTART ? (T)~T(0) : (T)data[i];
+    }
+    return narrowed;
+}
+
+IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int size, unsigned int primitive, bool narrow)
+    : m_Count(size / sizeof(unsigned int)), m_Type(GL_UNSIGNED_INT), m_Primitive(primitive)
 {
     ASSERT(sizeof(unsigned int) == sizeof(GLuint));
+    ASSERT(primitive == GL_TRIANGLES || primitive == GL_TRIANGLE_STRIP);
+
+    unsigned int maxIndex = 0, run = 0;
+    for(unsigned int i = 0; i < m_Count; i++) {
+        if(data[i] == PRIMITIVE_RESTART) {
+            run = 0;
+            continue;
+        }
+        maxIndex = std::max(maxIndex, data[i]);
+        if(primitive == GL_TRIANGLE_STRIP && ++run >= 3) {
+            m_Triangles++;
+        }
+    }
+    if(primitive == GL_TRIANGLES) {
+        m_Triangles = m_Count / 3;
+    }
+    if(narrow) {
+        m_Type = IndexTypeFor(maxIndex);
+    }
 
     GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    RenderState::getInstance().bindIndexBuffer(m_RendererID);
+    if(m_Type == GL_UNSIGNED_BYTE) {
+        std::vector<unsigned char> narrowed = narrowIndices<unsigned char>(data, m_Count);
+        GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, GetSize(), narrowed.data(), GL_STATIC_DRAW));
+    } else if(m_Type == GL_UNSIGNED_SHORT) {
+        std::vector<unsigned short> narrowed = narrowIndices<unsigned short>(data, m_Count);
+        GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, GetSize(), narrowed.data(), GL_STATIC_DRAW));
+    } else {
+        GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    }
 }
 
 IndexBuffer::~IndexBuffer()
 {
+    RenderState::getInstance().forget(RenderBinding::IndexBuffer, m_RendererID);
     GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
+unsigned int IndexBuffer::GetRestartIndex() const
+{
+    return m_Type == GL_UNSIGNED_BYTE ? 0xFF : m_Type == GL_UNSIGNED_SHORT ? 0xFFFF : PRIMITIVE_RESTART;
+}
+
+unsigned int IndexBuffer::GetSize() const
+{
+    return m_Count * sizeOfIndex(m_Type);
+}
+
 void IndexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+    RenderState::getInstance().bindIndexBuffer(m_RendererID);
 }
 
 void IndexBuffer::Unbind() const
 {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+    RenderState::getInstance().bindIndexBuffer(0);
+}
@@ -2,18 +2,40 @@
 
 #include <Debugger.h>
 
+// Marks the end of a strip in the indices given to IndexBuffer, stored as the largest value of the index type
+static constexpr unsigned int PRIMITIVE_RESTART = 0xFFFFFFFF;
+
+// Smallest index type able to hold `maxIndex` and still keep its largest value free for PRIMITIVE_RESTART
+unsigned int IndexTypeFor(unsigned int maxIndex);
+
 // EBO
 class IndexBuffer
 {
     private:
         unsigned int m_RendererID;
         unsigned int m_Count;
+        unsigned int m_Type;
+        unsigned int m_Primitive;
+        unsigned int m_Triangles = 0;
     public:
-        IndexBuffer(const unsigned int* data, unsigned int size);
+        /*
+        Indices are stored as GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, the smallest type fitting the
+        largest index unless `narrow` is false. `primitive` is GL_TRIANGLES or GL_TRIANGLE_STRIP, strips are
+        separated by PRIMITIVE_RESTART.
+        */
+        IndexBuffer(const unsigned int* data, unsigned int size, unsigned int primitive = GL_TRIANGLES, bool narrow = true);
         ~IndexBuffer();
 
         void Bind() const;
         void Unbind() const;
 
         inline unsigned int GetCount() const { return m_Count; }
-};
\ No newline at end of file
+        // Type and primitive of the draw calls
+        inline unsigned int GetType() const { return m_Type; }
+        inline unsigned int GetPrimitive() const { return m_Primitive; }
+        // PRIMITIVE_RESTART as stored in the buffer
+        unsigned int GetRestartIndex() const;
+        // Bytes of the indices on the GPU
+        unsigned int GetSize() const;
+        inline unsigned int GetTriangleCount() const { return m_Triangles; }
+};
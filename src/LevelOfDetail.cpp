@@ -0,0 +1,68 @@
+#include <LevelOfDetail.h>
+
+#include <CubeMesh.h>
+#include <Renderer.h>
+
+#include <cstring>
+
+// Texture unit of the baked face colors, unit 0 holds the sticker texture
+const unsigned int FACE_TEXTURE_SLOT = 1;
+
+LodMeshes::LodMeshes()
+    : m_FacePixels(FACE_ATLAS_WIDTH * FACE_ATLAS_HEIGHT * 4, 0)
+{
+    /* Stickers are re-uploaded whenever the cube changes, the box never does, only its texture */
+    std::vector<unsigned int> stickerIndices, boxIndices;
+    std::vector<float> vertices;
+    BuildStickerStrips(stickerIndices);
+    BuildBoxMesh(vertices, boxIndices);
+    m_StickerVertices.resize(STICKER_COUNT * 4 * CUBE_VERTEX_FLOATS, 0.0f);
+
+    /* The box follows the stickers in the buffer, its indices are moved past them */
+    unsigned int stickerVertexCount = STICKER_COUNT * 4;
+    for(unsigned int& index : boxIndices) {
+        index += stickerVertexCount;
+    }
+    vertices.insert(vertices.begin(), m_StickerVertices.begin(), m_StickerVertices.end());
+
+    m_Vb = std::make_unique<VertexBuffer>(vertices.data(), vertices.size() * sizeof(float), GL_DYNAMIC_DRAW);
+    m_Va = VertexArray::GetShared(m_Vb.get(), CUBE_VERTEX_FORMAT);
+    m_StickerIb = std::make_unique<IndexBuffer>(stickerIndices.data(), stickerIndices.size() * sizeof(unsigned int), GL_TRIANGLE_STRIP);
+    m_BoxIb = std::make_unique<IndexBuffer>(boxIndices.data(), boxIndices.size() * sizeof(unsigned int));
+    m_FaceTexture = std::make_unique<Texture>(FACE_ATLAS_WIDTH, FACE_ATLAS_HEIGHT, m_FacePixels.data());
+
+    m_Va->Unbind();
+}
+
+void LodMeshes::update(LodLevel level, const Cubie* cubes)
+{
+    if(level == LodLevel::Stickers) {
+        BuildStickerVertices(cubes, m_StickerVertices);
+        if(m_StickerVertices != m_UploadedStickers) {
+            m_Vb->SetData(m_StickerVertices.data(), m_StickerVertices.size() * sizeof(float));
+            m_UploadedStickers = m_StickerVertices;
+        }
+    } else if(level == LodLevel::Box) {
+        BakeFaceColors(cubes, m_FacePixels.data());
+        if(m_FacePixels != m_UploadedPixels) {
+            m_FaceTexture->SetData(m_FacePixels.data());
+            m_UploadedPixels = m_FacePixels;
+        }
+    }
+}
+
+void LodMeshes::draw(LodLevel level, Shader& shader, const glm::mat4& viewProjection)
+{
+    /* Stickers and box are already in world space */
+    shader.SetUniformMat4f("u_MVP", viewProjection);
+    shader.SetUniformMat4f("u_Model", glm::mat4(1.0f));
+
+    if(level == LodLevel::Stickers) {
+        Renderer::Draw(*m_Va, *m_StickerIb, shader);
+    } else if(level == LodLevel::Box) {
+        m_FaceTexture->Bind(FACE_TEXTURE_SLOT);
+        shader.SetUniform1i("u_Texture", FACE_TEXTURE_SLOT);
+        Renderer::Draw(*m_Va, *m_BoxIb, shader);
+        shader.SetUniform1i("u_Texture", 0);
+    }
+}
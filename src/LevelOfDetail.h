@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <IndexBuffer.h>
+#include <LodSelector.h>
+#include <Shader.h>
+#include <Texture.h>
+#include <VertexArray.h>
+#include <VertexBuffer.h>
+
+#include "RubiksCube.h"
+
+#include <memory>
+#include <vector>
+
+// GPU resources of the reduced levels, rebuilt from the cube state only when the stickers change
+class LodMeshes
+{
+    private:
+        // Stickers then the box in one buffer, both meshes have the cube vertex format and share a vertex array
+        std::unique_ptr<VertexBuffer> m_Vb;
+        std::shared_ptr<VertexArray> m_Va;
+
+        std::vector<float> m_StickerVertices;
+        std::unique_ptr<IndexBuffer> m_StickerIb;
+
+        std::vector<unsigned char> m_FacePixels;
+        std::unique_ptr<IndexBuffer> m_BoxIb;
+        std::unique_ptr<Texture> m_FaceTexture;
+
+        // Sticker mesh of the last upload, compared to skip redundant uploads
+        std::vector<float> m_UploadedStickers;
+        std::vector<unsigned char> m_UploadedPixels;
+
+    public:
+        LodMeshes();
+
+        // Refresh the sticker mesh and face texture of a level if the cube changed
+        void update(LodLevel level, const Cubie* cubes);
+
+        // Draw a reduced level, the shader is expected to be bound
+        void draw(LodLevel level, Shader& shader, const glm::mat4& viewProjection);
+};
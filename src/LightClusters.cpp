@@ -0,0 +1,109 @@
+#include <LightClusters.h>
+
+#include <Random.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+LightClusters::LightClusters()
+    : m_Clusters(2 * CLUSTER_COUNT, 0), m_Counts(CLUSTER_COUNT, 0)
+{
+}
+
+int LightClusters::sliceOf(float depth) const
+{
+    return std::min(std::max((int)(std::log(depth) * m_Scale + m_Bias), 0), CLUSTER_GRID_Z - 1);
+}
+
+void LightClusters::build(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection)
+{
+    // Clipping planes from the projection, perspective or orthographic like LodSelector
+    bool orthographic = projection[3][3] == 1.0f;
+    float near = orthographic ? (projection[3][2] + 1.0f) / projection[2][2] : projection[3][2] / (projection[2][2] - 1.0f);
+    float far = orthographic ? (projection[3][2] - 1.0f) / projection[2][2] : projection[3][2] / (projection[2][2] + 1.0f);
+    near = std::max(near, 1e-3f);
+    far = std::max(far, near * 1.001f);
+    m_Scale = CLUSTER_GRID_Z / std::log(far / near);
+    m_Bias = -CLUSTER_GRID_Z * std::log(near) / std::log(far / near);
+
+    m_Ranges.clear();
+    std::fill(m_Counts.begin(), m_Counts.end(), 0);
+    for(const PointLight& light : lights) {
+        glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+        float depth = -center.z, r = light.radius;
+        if(depth + r < near || depth - r > far) {
+            m_Ranges.push_back({ 0, -1, 0, -1, 0, -1 });
+            continue;
+        }
+
+        Range range = { 0, CLUSTER_GRID_X - 1, 0, CLUSTER_GRID_Y - 1, sliceOf(std::max(depth - r, near)), sliceOf(std::min(depth + r, far)) };
+
+        // Screen rectangle of the box around the sphere, the whole screen when it crosses the near plane
+        if(orthographic || depth - r > near) {
+            glm::vec2 low(1.0f), high(-1.0f);
+            for(int corner = 0; corner < 8; corner++) {
+                glm::vec3 offset(corner & 1 ? r : -r, corner & 2 ? r : -r, corner & 4 ? r : -r);
+                glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                low = corner ? glm::min(low, ndc) : ndc;
+                high = corner ? glm::max(high, ndc) : ndc;
+            }
+            if(high.x < -1.0f || high.y < -1.0f || low.x > 1.0f || low.y > 1.0f) {
+                m_Ranges.push_back({ 0, -1, 0, -1, 0, -1 });
+                continue;
+            }
+            range.x0 = std::max((int)((low.x * 0.5f + 0.5f) * CLUSTER_GRID_X), 0);
+            range.x1 = std::min((int)((high.x * 0.5f + 0.5f) * CLUSTER_GRID_X), CLUSTER_GRID_X - 1);
+            range.y0 = std::max((int)((low.y * 0.5f + 0.5f) * CLUSTER_GRID_Y), 0);
+            range.y1 = std::min((int)((high.y * 0.5f + 0.5f) * CLUSTER_GRID_Y), CLUSTER_GRID_Y - 1);
+        }
+        m_Ranges.push_back(range);
+
+        for(int z = range.z0; z <= range.z1; z++) {
+            for(int y = range.y0; y <= range.y1; y++) {
+                for(int x = range.x0; x <= range.x1; x++) {
+                    m_Counts[x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z)]++;
+                }
+            }
+        }
+    }
+
+    // Offsets from the counts, then every light writes its index into the clusters it overlaps
+    uint32_t total = 0;
+    for(int c = 0; c < CLUSTER_COUNT; c++) {
+        m_Clusters[2 * c] = total;
+        m_Clusters[2 * c + 1] = 0;
+        total += m_Counts[c];
+    }
+    m_Indices.resize(total);
+    for(size_t i = 0; i < m_Ranges.size(); i++) {
+        const Range& range = m_Ranges[i];
+        for(int z = range.z0; z <= range.z1; z++) {
+            for(int y = range.y0; y <= range.y1; y++) {
+                for(int x = range.x0; x <= range.x1; x++) {
+                    uint32_t* cluster = &m_Clusters[2 * (x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z))];
+                    m_Indices[cluster[0] + cluster[1]++] = (uint32_t)i;
+                }
+            }
+        }
+    }
+}
+
+std::vector<PointLight> ScatterPointLights(int count, const glm::vec3& center, float radius, uint64_t seed)
+{
+    Xoshiro256 random(seed);
+    auto uniform = [&random]() { return (float)(random.next() >> 40) * (1.0f / 16777216.0f); };
+
+    std::vector<PointLight> lights;
+    for(int i = 0; i < count; i++) {
+        // Uniform on the sphere, the radius of influence reaches the center
+        float z = 2.0f * uniform() - 1.0f, angle = glm::two_pi<float>() * uniform();
+        float ring = std::sqrt(1.0f - z * z);
+        glm::vec3 direction(ring * std::cos(angle), z, ring * std::sin(angle));
+        glm::vec3 color = glm::mix(glm::vec3(0.2f), glm::vec3(uniform(), uniform(), uniform()), 0.8f);
+        lights.push_back({ center + direction * radius, 1.5f * radius, color });
+    }
+    return lights;
+}
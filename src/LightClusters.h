@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Froxel grid of the clustered lighting: screen tiles times depth slices
+static constexpr int CLUSTER_GRID_X = 16;
+static constexpr int CLUSTER_GRID_Y = 9;
+static constexpr int CLUSTER_GRID_Z = 24;
+static constexpr int CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+
+struct PointLight
+{
+    glm::vec3 position;     // world space
+    float radius;           // no light beyond this distance
+    glm::vec3 color;
+};
+
+/*
+Assigns point lights to the clusters of a view frustum, so a fragment only shades the lights of its cluster.
+Depth slices are exponential between the near and far planes: slice = log(depth) * scale + bias. A light is added
+to every cluster overlapped by the screen rectangle and depth range of its bounding sphere, a conservative test.
+*/
+class LightClusters
+{
+    private:
+        // Offset into m_Indices and count of every cluster, x fastest then y then z
+        std::vector<uint32_t> m_Clusters;
+        std::vector<uint32_t> m_Indices;
+        float m_Scale = 0.0f;
+        float m_Bias = 0.0f;
+
+        // Cluster ranges of every light, inclusive, filled by build
+        struct Range { int x0, x1, y0, y1, z0, z1; };
+        std::vector<Range> m_Ranges;
+        std::vector<uint32_t> m_Counts;
+
+        int sliceOf(float depth) const;
+
+    public:
+        LightClusters();
+
+        void build(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection);
+
+        // CLUSTER_COUNT pairs of (offset, count)
+        const std::vector<uint32_t>& getClusters() const { return m_Clusters; }
+        const std::vector<uint32_t>& getIndices() const { return m_Indices; }
+        float getDepthScale() const { return m_Scale; }
+        float getDepthBias() const { return m_Bias; }
+};
+
+// `count` lights of random colors spread around a sphere of `radius`, the same for a given seed
+std::vector<PointLight> ScatterPointLights(int count, const glm::vec3& center, float radius, uint64_t seed = 1);
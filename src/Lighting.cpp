@@ -0,0 +1,62 @@
+#include <Lighting.h>
+
+Lighting::Lighting()
+    : m_Sun({ glm::normalize(glm::vec3(-0.4f, -1.0f, -0.6f)), glm::vec3(0.8f), glm::vec3(0.3f) }),
+      m_LightData(GL_RGBA32F), m_ClusterData(GL_RG32UI), m_LightIndices(GL_R32UI)
+{
+}
+
+void Lighting::setPointLights(const std::vector<PointLight>& lights)
+{
+    m_PointLights = lights;
+    m_ClustersValid = false;
+
+    // Two texels per light: position and radius, then color
+    m_LightTexels.clear();
+    for(const PointLight& light : m_PointLights) {
+        m_LightTexels.insert(m_LightTexels.end(), {
+            light.position.x, light.position.y, light.position.z, light.radius,
+            light.color.r, light.color.g, light.color.b, 0.0f
+        });
+    }
+    m_LightData.SetData(m_LightTexels.data(), (unsigned int)(m_LightTexels.size() * sizeof(float)));
+}
+
+void Lighting::update(const Camera& camera)
+{
+    glm::mat4 view = camera.GetViewMatrix(), projection = camera.GetProjectionMatrix();
+    if(m_ClustersValid && view == m_ClusteredView && projection == m_ClusteredProjection) { return; }
+
+    m_Clusters.build(m_PointLights, view, projection);
+    m_ClusterData.SetData(m_Clusters.getClusters().data(), (unsigned int)(m_Clusters.getClusters().size() * sizeof(uint32_t)));
+    m_LightIndices.SetData(m_Clusters.getIndices().data(), (unsigned int)(m_Clusters.getIndices().size() * sizeof(uint32_t)));
+
+    m_ClusteredView = view;
+    m_ClusteredProjection = projection;
+    m_ClustersValid = true;
+}
+
+void Lighting::apply(Shader& shader, const Camera& camera)
+{
+    m_ShadowMap.bindTexture(SHADOW_MAP_SLOT);
+    m_LightData.Bind(POINT_LIGHT_SLOT);
+    m_ClusterData.Bind(CLUSTER_SLOT);
+    m_LightIndices.Bind(LIGHT_INDEX_SLOT);
+
+    shader.Bind();
+    shader.SetUniformMat4f("u_View", camera.GetViewMatrix());
+    shader.SetUniformMat4f("u_LightViewProjection", m_ShadowMap.getLightViewProjection());
+    shader.SetUniform3f("u_ViewPosition", camera.GetPosition());
+    shader.SetUniform3f("u_LightDirection", m_Sun.direction);
+    shader.SetUniform3f("u_LightColor", m_Sun.color);
+    shader.SetUniform3f("u_AmbientColor", m_Sun.ambient);
+    shader.SetUniform1f("u_Shininess", m_Shininess);
+
+    shader.SetUniform1i("u_ShadowMap", SHADOW_MAP_SLOT);
+    shader.SetUniform1i("u_PointLights", POINT_LIGHT_SLOT);
+    shader.SetUniform1i("u_Clusters", CLUSTER_SLOT);
+    shader.SetUniform1i("u_LightIndices", LIGHT_INDEX_SLOT);
+    shader.SetUniform3i("u_ClusterGrid", glm::ivec3(CLUSTER_GRID_X, CLUSTER_GRID_Y, CLUSTER_GRID_Z));
+    shader.SetUniform2f("u_ClusterDepth", glm::vec2(m_Clusters.getDepthScale(), m_Clusters.getDepthBias()));
+    shader.SetUniform2f("u_ScreenSize", glm::vec2((float)camera.GetWidth(), (float)camera.GetHeight()));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Camera.h>
+#include <LightClusters.h>
+#include <Shader.h>
+#include <ShadowMap.h>
+#include <TextureBuffer.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Texture units of the lighting inputs, after the sticker texture (0) and the LOD face colors (1)
+static constexpr unsigned int SHADOW_MAP_SLOT = 2;
+static constexpr unsigned int POINT_LIGHT_SLOT = 3;
+static constexpr unsigned int CLUSTER_SLOT = 4;
+static constexpr unsigned int LIGHT_INDEX_SLOT = 5;
+
+struct DirectionalLight
+{
+    glm::vec3 direction;    // the light travels along it
+    glm::vec3 color;
+    glm::vec3 ambient;
+};
+
+/*
+Forward+ lighting of the lit shaders (see lighting.glsl): Blinn-Phong from a directional light with a shadow map,
+and point lights looked up in the cluster of each fragment, so the shading cost of a pixel depends on the lights
+around it rather than on their total count or on the number of puzzles.
+*/
+class Lighting
+{
+    private:
+        DirectionalLight m_Sun;
+        float m_Shininess = 64.0f;
+
+        std::vector<PointLight> m_PointLights;
+        LightClusters m_Clusters;
+        bool m_ClustersValid = false;
+        glm::mat4 m_ClusteredView = glm::mat4(1.0f);
+        glm::mat4 m_ClusteredProjection = glm::mat4(1.0f);
+
+        ShadowMap m_ShadowMap;
+        TextureBuffer m_LightData;
+        TextureBuffer m_ClusterData;
+        TextureBuffer m_LightIndices;
+        std::vector<float> m_LightTexels;
+
+    public:
+        Lighting();
+
+        void setPointLights(const std::vector<PointLight>& lights);
+        const std::vector<PointLight>& getPointLights() const { return m_PointLights; }
+        const DirectionalLight& getSun() const { return m_Sun; }
+
+        ShadowMap& getShadowMap() { return m_ShadowMap; }
+
+        // Assign the point lights to the clusters of the camera, only when the camera or the lights changed
+        void update(const Camera& camera);
+
+        // Set the lighting uniforms and bind its textures, binds the shader
+        void apply(Shader& shader, const Camera& camera);
+};
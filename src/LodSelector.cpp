@@ -0,0 +1,42 @@
+#include <LodSelector.h>
+
+LodLevel LodSelector::selectLevel(float pixels, float distance) const
+{
+    // Thresholds are lowered for the level currently in use so that it is kept a bit longer
+    float cubiesPixels = m_CubiesPixels * (m_Level == LodLevel::Cubies ? 1.0f - m_Hysteresis : 1.0f + m_Hysteresis);
+    float stickersPixels = m_StickersPixels * (m_Level == LodLevel::Box ? 1.0f + m_Hysteresis : 1.0f - m_Hysteresis);
+
+    if(pixels >= cubiesPixels && distance <= m_MaxCubiesDistance) {
+        return LodLevel::Cubies;
+    }
+    if(pixels >= stickersPixels) {
+        return LodLevel::Stickers;
+    }
+    return LodLevel::Box;
+}
+
+void LodSelector::update(const Camera& camera, const glm::vec3& center, float radius, float deltaTime)
+{
+    glm::mat4 projection = camera.GetProjectionMatrix();
+    float distance = glm::length(glm::vec3(camera.GetViewMatrix() * glm::vec4(center, 1.0f)));
+
+    // projection[1][1] is the vertical scale of the projection, perspective divides it by the distance
+    bool orthographic = projection[3][3] == 1.0f;
+    float scale = projection[1][1] * (orthographic ? 1.0f : 1.0f / glm::max(distance, 1e-4f));
+    update(radius * scale * (float)camera.GetHeight(), distance, deltaTime);
+}
+
+void LodSelector::update(float projectedPixels, float distance, float deltaTime)
+{
+    m_ProjectedPixels = projectedPixels;
+
+    // A running cross-fade finishes before the next switch, restarting it would drop the level fading out at once
+    LodLevel level = selectLevel(m_ProjectedPixels, distance);
+    if(level != m_Level && !isFading()) {
+        m_PreviousLevel = m_Level;
+        m_Level = level;
+        m_Fade = m_FadeTime > 0.0f ? 0.0f : 1.0f;
+    } else if(m_Fade < 1.0f) {
+        m_Fade = glm::min(1.0f, m_Fade + deltaTime / m_FadeTime);
+    }
+}
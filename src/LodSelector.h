@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Camera.h>
+
+#include <glm/glm.hpp>
+
+/*
+LodLevel:
+    Cubies: every cubie drawn with the full beveled mesh (27 draw calls),
+    Stickers: all stickers merged into a single mesh of quads (1 draw call),
+    Box: a single box textured with the baked face colors (1 draw call)
+*/
+enum class LodLevel
+{
+    Cubies = 0,
+    Stickers = 1,
+    Box = 2
+};
+
+// Picks a level from the projected size of the cube and cross-fades between levels
+class LodSelector
+{
+    private:
+        // Minimal projected diameter in pixels to use the Cubies and Stickers levels
+        float m_CubiesPixels = 160.0f;
+        float m_StickersPixels = 40.0f;
+        // Beyond this distance the Cubies level is never used, whatever the projected size
+        float m_MaxCubiesDistance = 60.0f;
+        // Relative margin a threshold has to be crossed by before switching, avoids flickering
+        float m_Hysteresis = 0.15f;
+        // Seconds a cross-fade between two levels takes
+        float m_FadeTime = 0.25f;
+
+        LodLevel m_Level = LodLevel::Cubies;
+        LodLevel m_PreviousLevel = LodLevel::Cubies;
+        float m_Fade = 1.0f;
+        float m_ProjectedPixels = 0.0f;
+
+        LodLevel selectLevel(float pixels, float distance) const;
+
+    public:
+        // Update the selection for a bounding sphere, deltaTime in seconds drives the cross-fade
+        void update(const Camera& camera, const glm::vec3& center, float radius, float deltaTime);
+        // Same from the projected diameter in pixels and the distance to the camera
+        void update(float projectedPixels, float distance, float deltaTime);
+
+        void setThresholds(float cubiesPixels, float stickersPixels) { m_CubiesPixels = cubiesPixels; m_StickersPixels = stickersPixels; }
+        void setFadeTime(float seconds) { m_FadeTime = seconds; }
+
+        // Whether the previous level has to be drawn as well, faded out
+        bool isFading() const { return m_Fade < 1.0f; }
+
+        // Dither fade values for the "u_Fade" shader uniform (0 draws opaque)
+        float getFadeIn() const { return isFading() ? glm::max(m_Fade, 1e-3f) : 0.0f; }
+        float getFadeOut() const { return -m_Fade; }
+
+        LodLevel getLevel() const { return m_Level; }
+        LodLevel getPreviousLevel() const { return m_PreviousLevel; }
+        float getProjectedPixels() const { return m_ProjectedPixels; }
+};
@@ -0,0 +1,118 @@
+#include <MappedFile.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) { return false; }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Mapping = mapping;
+    m_Data = (const unsigned char*)data;
+    m_Size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {}
+
+void MappedFile::evict(size_t offset, size_t length) const {}
+
+void MappedFile::close()
+{
+    if(m_Data) { UnmapViewOfFile(m_Data); }
+    if(m_Mapping) { CloseHandle(m_Mapping); }
+    if(m_File) { CloseHandle(m_File); }
+    m_Data = nullptr;
+    m_Mapping = nullptr;
+    m_File = nullptr;
+    m_Size = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if(file < 0) { return false; }
+
+    struct stat info;
+    if(fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file
+    void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if(data == MAP_FAILED) { return false; }
+
+    m_Data = (const unsigned char*)data;
+    m_Size = (size_t)info.st_size;
+    return true;
+}
+
+// madvise takes whole pages: the pages overlapping the range
+static void advise(const unsigned char* data, size_t size, size_t offset, size_t length, int advice)
+{
+    static const size_t PAGE_SIZE = (size_t)sysconf(_SC_PAGESIZE);
+    if(!data || offset >= size) { return; }
+
+    size_t begin = offset / PAGE_SIZE * PAGE_SIZE;
+    size_t end = std::min(offset + length, size);
+    madvise((void*)(data + begin), end - begin, advice);
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const
+{
+    advise(m_Data, m_Size, offset, length, MADV_WILLNEED);
+}
+
+void MappedFile::evict(size_t offset, size_t length) const
+{
+    // The mapping is read-only, dropped pages never lose data
+    advise(m_Data, m_Size, offset, length, MADV_DONTNEED);
+}
+
+void MappedFile::close()
+{
+    if(m_Data) { munmap((void*)m_Data, m_Size); }
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file, pages are loaded by the OS on first access
+class MappedFile
+{
+    private:
+        const unsigned char* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False when the file doesn't exist, is empty or can't be mapped
+        bool open(const std::string& path);
+        void close();
+
+        // Hints to the OS on the pages of a range, no-ops where unsupported (Windows)
+        // Start reading the range in the background
+        void prefetch(size_t offset, size_t length) const;
+        // Drop the range from the memory of the process, it is read again from the file when accessed
+        void evict(size_t offset, size_t length) const;
+
+        bool isOpen() const { return m_Data != nullptr; }
+        const unsigned char* data() const { return m_Data; }
+        size_t size() const { return m_Size; }
+};
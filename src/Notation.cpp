@@ -0,0 +1,197 @@
+#include <Notation.h>
+
+#include <algorithm>
+#include <cctype>
+
+// Letters of the moves of each axis
+static const char POSITIVE_FACES[AXIS_COUNT] = { 'R', 'U', 'F' };
+static const char NEGATIVE_FACES[AXIS_COUNT] = { 'L', 'D', 'B' };
+static const char SLICES[AXIS_COUNT] = { 'M', 'E', 'S' };
+static const char ROTATIONS[AXIS_COUNT] = { 'x', 'y', 'z' };
+// M and E turn like L and D, S like F
+static const bool SLICE_POSITIVE[AXIS_COUNT] = { false, false, true };
+
+static const int MAX_LAYERS = 3;
+
+static int axisOf(const char* letters, char letter)
+{
+    for(int axis = 0; axis < AXIS_COUNT; axis++) {
+        if(letters[axis] == letter) { return axis; }
+    }
+    return -1;
+}
+
+// Layers `first` to `last` counted from a side, 1 being the face
+static uint8_t layersFromSide(int first, int last, bool positive)
+{
+    uint8_t layers = 0;
+    for(int depth = first; depth <= last; depth++) {
+        layers |= 1 << (positive ? MAX_LAYERS - depth : depth - 1);
+    }
+    return layers;
+}
+
+static bool fail(std::string* error, const std::string& message, size_t position)
+{
+    if(error) { *error = message + " at position " + std::to_string(position + 1); }
+    return false;
+}
+
+bool ParseMoves(const std::string& text, std::vector<LayerTurn>& turns, std::string* error)
+{
+    size_t i = 0;
+    auto readNumber = [&text, &i]() {
+        int number = 0;
+        while(i < text.size() && std::isdigit((unsigned char)text[i])) {
+            number = std::min(number * 10 + (text[i++] - '0'), 1000);
+        }
+        return number;
+    };
+
+    while(i < text.size()) {
+        if(std::isspace((unsigned char)text[i])) {
+            i++;
+            continue;
+        }
+
+        size_t start = i;
+        int prefix = readNumber();
+        if(i >= text.size()) { return fail(error, "Expected a move after the layer count", start); }
+
+        char letter = text[i++];
+        char upper = (char)std::toupper((unsigned char)letter);
+        int axis;
+        bool positive;
+        uint8_t layers;
+        if((axis = axisOf(POSITIVE_FACES, upper)) >= 0 || (axis = axisOf(NEGATIVE_FACES, upper)) >= 0) {
+            positive = axisOf(POSITIVE_FACES, upper) >= 0;
+            bool wide = letter != upper;
+            if(!wide && i < text.size() && text[i] == 'w') {
+                wide = true;
+                i++;
+            }
+
+            int depth = prefix ? prefix : (wide ? 2 : 1);
+            if(depth > MAX_LAYERS) {
+                return fail(error, "Layer " + std::to_string(depth) + " doesn't exist on a 3x3x3 cube", start);
+            }
+            layers = layersFromSide(wide ? 1 : depth, depth, positive);
+        } else if((axis = axisOf(SLICES, letter)) >= 0 || (axis = axisOf(ROTATIONS, letter)) >= 0) {
+            if(prefix) { return fail(error, std::string("'") + letter + "' takes no layer count", start); }
+            bool slice = axisOf(SLICES, letter) >= 0;
+            positive = !slice || SLICE_POSITIVE[axis];
+            layers = slice ? 1 << 1 : 7;
+        } else {
+            return fail(error, std::string("Unknown move '") + letter + "'", start);
+        }
+
+        bool hasCount = i < text.size() && std::isdigit((unsigned char)text[i]);
+        int count = hasCount ? readNumber() : 1;
+        if(i < text.size() && text[i] == '\'') {
+            count = -count;
+            i++;
+        }
+
+        // Clockwise from the face, converted to clockwise from the positive side of the axis
+        int quarters = ((positive ? count : -count) % 4 + 4) % 4;
+        if(quarters) { turns.push_back({ (uint8_t)axis, layers, (uint8_t)quarters }); }
+    }
+    return true;
+}
+
+std::vector<LayerTurn> SimplifyTurns(const std::vector<LayerTurn>& turns)
+{
+    // Net quarters of every layer of runs of turns around the same axis
+    struct Run
+    {
+        int axis;
+        int quarters[MAX_LAYERS];
+    };
+    std::vector<Run> runs;
+
+    for(const LayerTurn& turn : turns) {
+        if(runs.empty() || runs.back().axis != turn.axis) {
+            runs.push_back({ turn.axis, { 0, 0, 0 } });
+        }
+
+        Run& run = runs.back();
+        bool cancelled = true;
+        for(int layer = 0; layer < MAX_LAYERS; layer++) {
+            if(turn.layers & (1 << layer)) {
+                run.quarters[layer] = (run.quarters[layer] + turn.quarters) % 4;
+            }
+            cancelled = cancelled && run.quarters[layer] == 0;
+        }
+        // Lets the previous run merge with the next turns
+        if(cancelled) { runs.pop_back(); }
+    }
+
+    // One turn per distinct amount, so that e.g. R L' and x come out the same whatever the input order
+    std::vector<LayerTurn> result;
+    for(const Run& run : runs) {
+        for(int quarters = 1; quarters < 4; quarters++) {
+            uint8_t layers = 0;
+            for(int layer = 0; layer < MAX_LAYERS; layer++) {
+                if(run.quarters[layer] == quarters) { layers |= 1 << layer; }
+            }
+            if(layers) { result.push_back({ (uint8_t)run.axis, layers, (uint8_t)quarters }); }
+        }
+    }
+    return result;
+}
+
+std::string FormatTurns(const std::vector<LayerTurn>& turns)
+{
+    static const char* SUFFIXES[4] = { "", "", "2", "'" };
+
+    std::string text;
+    auto append = [&text](char letter, const char* wide, int quarters) {
+        if(!text.empty()) { text += ' '; }
+        text += letter;
+        text += wide;
+        text += SUFFIXES[quarters];
+    };
+
+    for(const LayerTurn& turn : turns) {
+        int axis = turn.axis;
+        int quarters = turn.quarters;
+        int inverse = (4 - quarters) % 4;
+        switch(turn.layers) {
+            case 1: append(NEGATIVE_FACES[axis], "", inverse); break;
+            case 2: append(SLICES[axis], "", SLICE_POSITIVE[axis] ? quarters : inverse); break;
+            case 3: append(NEGATIVE_FACES[axis], "w", inverse); break;
+            case 4: append(POSITIVE_FACES[axis], "", quarters); break;
+            case 5:
+                append(POSITIVE_FACES[axis], "", quarters);
+                append(NEGATIVE_FACES[axis], "", inverse);
+                break;
+            case 6: append(POSITIVE_FACES[axis], "w", quarters); break;
+            case 7: append(ROTATIONS[axis], "", quarters); break;
+            default: break;
+        }
+    }
+    return text;
+}
+
+Algorithm::Algorithm(const std::vector<LayerTurn>& turns)
+    : m_Turns(SimplifyTurns(turns))
+{
+    for(const LayerTurn& turn : m_Turns) {
+        m_Permutation = m_Permutation.multiply(FaceletPermutation::fromTurn(turn));
+    }
+}
+
+bool Algorithm::compile(const std::string& text, Algorithm& algorithm, std::string* error)
+{
+    std::vector<LayerTurn> turns;
+    if(!ParseMoves(text, turns, error)) { return false; }
+    algorithm = Algorithm(turns);
+    return true;
+}
+
+void Algorithm::apply(RubiksCube& cube) const
+{
+    for(const LayerTurn& turn : m_Turns) {
+        cube.rotateLayers(turn.axis, turn.layers, turn.quarters);
+    }
+}
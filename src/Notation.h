@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Facelets.h>
+#include "RubiksCube.h"
+
+#include <string>
+#include <vector>
+
+/*
+WCA notation, moves may be separated by spaces or not:
+    R L U D F B     face turns, clockwise seen from the face
+    Rw, r           wide turns: the face and the middle layer
+    M E S           middle layers, turning like L, D and F
+    x y z           cube rotations, turning like R, U and F
+    2R, 3Rw         NxN prefixes: the 2nd layer from R, the 3 outer layers from R (up to 3 on this cube)
+followed by an optional count and ', e.g. U2, R', F2'.
+*/
+
+// Append the turns of a sequence, false with a message in `error` on a syntax error
+bool ParseMoves(const std::string& text, std::vector<LayerTurn>& turns, std::string* error = nullptr);
+
+// Merge consecutive turns around the same axis, which commute, and drop those cancelling out
+std::vector<LayerTurn> SimplifyTurns(const std::vector<LayerTurn>& turns);
+
+// Turns in notation, e.g. "R U2 M' y"
+std::string FormatTurns(const std::vector<LayerTurn>& turns);
+
+// A simplified sequence precomposed into a single permutation: applying it costs the same whatever its length
+class Algorithm
+{
+    private:
+        std::vector<LayerTurn> m_Turns;
+        FaceletPermutation m_Permutation = FaceletPermutation::identity();
+
+    public:
+        Algorithm() {};
+        explicit Algorithm(const std::vector<LayerTurn>& turns);
+
+        // Parse, simplify and precompose, false with a message in `error` on a syntax error
+        static bool compile(const std::string& text, Algorithm& algorithm, std::string* error = nullptr);
+
+        const std::vector<LayerTurn>& getTurns() const { return m_Turns; }
+        const FaceletPermutation& getPermutation() const { return m_Permutation; }
+        std::string toString() const { return FormatTurns(m_Turns); }
+
+        // Turn the layers of the 3D cube one by one, whatever its rotation angle
+        void apply(RubiksCube& cube) const;
+};
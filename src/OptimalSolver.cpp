@@ -0,0 +1,190 @@
+#include <OptimalSolver.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <iostream>
+
+// Turning the same face twice in a row is never shorter, and opposite faces commute so only one order is searched
+static bool isRedundant(int face, int lastFace)
+{
+    return lastFace >= 0 && (face == lastFace || (face / 2 == lastFace / 2 && face < lastFace));
+}
+
+OptimalSolver::~OptimalSolver()
+{
+    m_Cancel = true;
+    if(m_Thread.joinable()) { m_Thread.join(); }
+}
+
+bool OptimalSolver::load(const std::string& directory)
+{
+    bool loaded = true;
+    for(int k = 0; k < PATTERN_KIND_COUNT; k++) {
+        PatternKind kind = (PatternKind)k;
+        loaded &= m_Databases[k].load(directory + "/" + PatternDatabase::getFileName(kind), kind);
+    }
+    return loaded;
+}
+
+bool OptimalSolver::isLoaded() const
+{
+    return std::all_of(std::begin(m_Databases), std::end(m_Databases), [](const PatternDatabase& db) { return db.isLoaded(); });
+}
+
+int OptimalSolver::heuristic(const PatternCoords& coords) const
+{
+    int corners = m_Databases[(int)PatternKind::Corners].get(coords.corners);
+    int edgesLow = m_Databases[(int)PatternKind::EdgesLow].get(coords.edgesLow);
+    int edgesHigh = m_Databases[(int)PatternKind::EdgesHigh].get(coords.edgesHigh);
+    return std::max(corners, std::max(edgesLow, edgesHigh));
+}
+
+bool OptimalSolver::search(const PatternCoords& coords, int depth, int bound, int lastFace, int item, int* path, unsigned long long& nodes) const
+{
+    nodes++;
+    int estimate = heuristic(coords);
+    if(depth + estimate > bound) { return false; }
+    // Only the solved state is at distance 0 in all three databases
+    if(estimate == 0) { return true; }
+
+    // Stop when another thread already found a solution in an earlier work item
+    if(m_Cancel.load(std::memory_order_relaxed) || m_BestItem.load(std::memory_order_relaxed) < item) { return false; }
+
+    const PatternMoves& moves = PatternMoves::getInstance();
+    for(int move = 0; move < MOVE_COUNT; move++) {
+        int face = move / 3;
+        if(isRedundant(face, lastFace)) { continue; }
+
+        path[depth] = move;
+        if(search(moves.apply(coords, move), depth + 1, bound, face, item, path, nodes)) { return true; }
+    }
+    return false;
+}
+
+void OptimalSolver::collectPrefixes(const PatternCoords& coords, int depth, int length, int bound, int lastFace, int* path, std::vector<Prefix>& prefixes) const
+{
+    if(depth + heuristic(coords) > bound) { return; }
+    if(depth == length) {
+        Prefix prefix;
+        prefix.coords = coords;
+        std::copy(path, path + length, prefix.moves);
+        prefix.lastFace = lastFace;
+        prefixes.push_back(prefix);
+        return;
+    }
+
+    const PatternMoves& moves = PatternMoves::getInstance();
+    for(int move = 0; move < MOVE_COUNT; move++) {
+        int face = move / 3;
+        if(isRedundant(face, lastFace)) { continue; }
+
+        path[depth] = move;
+        collectPrefixes(moves.apply(coords, move), depth + 1, length, bound, face, path, prefixes);
+    }
+}
+
+bool OptimalSolver::solve(const CubeState& state, std::vector<int>& moves, int threads, int maxDepth)
+{
+    moves.clear();
+    m_Cancel = false;
+    m_Nodes = 0;
+    if(!isLoaded() || !state.isSolvable()) { return false; }
+
+    if(threads <= 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    // Paths are sized for God's number, no solvable state needs more
+    maxDepth = std::min(maxDepth, OPTIMAL_MAX_DEPTH);
+
+    PatternCoords start = PatternMoves::getInstance().fromState(state);
+    for(int bound = heuristic(start); bound <= maxDepth; bound++) {
+        /* Enumerate the first plies, then let the workers search below them */
+        int length = std::min(OPTIMAL_SPLIT_DEPTH, bound);
+        int path[OPTIMAL_MAX_DEPTH + 1];
+        std::vector<Prefix> prefixes;
+        collectPrefixes(start, 0, length, bound, -1, path, prefixes);
+
+        m_BestItem = INT_MAX;
+        std::atomic<int> nextItem(0);
+        std::vector<int> solution;
+        std::mutex solutionMutex;
+
+        auto work = [&]() {
+            int workerPath[OPTIMAL_MAX_DEPTH + 1];
+            unsigned long long nodes = 0;
+            for(;;) {
+                int item = nextItem.fetch_add(1);
+                if(item >= (int)prefixes.size() || item > m_BestItem || m_Cancel) { break; }
+
+                const Prefix& prefix = prefixes[item];
+                std::copy(prefix.moves, prefix.moves + length, workerPath);
+                if(!search(prefix.coords, length, bound, prefix.lastFace, item, workerPath, nodes)) { continue; }
+
+                // Keep the solution of the earliest work item so that results don't depend on thread timing
+                std::lock_guard<std::mutex> lock(solutionMutex);
+                if(item < m_BestItem) {
+                    m_BestItem = item;
+                    solution.assign(workerPath, workerPath + bound);
+                }
+            }
+            m_Nodes += nodes;
+        };
+
+        std::vector<std::thread> workers;
+        for(int t = 1; t < threads; t++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+
+        if(m_BestItem != INT_MAX) {
+            moves = solution;
+            return true;
+        }
+        if(m_Cancel) { return false; }
+    }
+    return false;
+}
+
+void OptimalSolver::requestSolve(const CubeState& state)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_Solving) {
+        std::cout << "Optimal solver: already solving" << std::endl;
+        return;
+    }
+    if(!isLoaded()) {
+        std::cout << "Optimal solver: pattern databases aren't loaded, generate them with make pdb" << std::endl;
+        return;
+    }
+
+    if(m_Thread.joinable()) { m_Thread.join(); }
+    m_Solving = true;
+    m_Thread = std::thread([this, state]() {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> moves;
+        bool solved = solve(state, moves);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if(solved) {
+            std::cout << "Optimal solution (" << moves.size() << " moves, " << m_Nodes << " nodes, " << seconds << "s): "
+                << FormatMoves(moves) << std::endl;
+            m_Solution = moves;
+            m_HasSolution = true;
+            if(m_OnSolved) { m_OnSolved(); }
+        }
+        m_Solving = false;
+    });
+}
+
+bool OptimalSolver::pollSolution(std::vector<int>& moves)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(!m_HasSolution) { return false; }
+
+    moves = m_Solution;
+    m_HasSolution = false;
+    return true;
+}
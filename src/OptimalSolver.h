@@ -0,0 +1,81 @@
+#pragma once
+
+#include <CubeState.h>
+#include <PatternDatabase.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// God's number in the face turn metric
+static constexpr int OPTIMAL_MAX_DEPTH = 20;
+
+// Plies enumerated up front, every sequence of this length is a work item for the search threads
+static constexpr int OPTIMAL_SPLIT_DEPTH = 3;
+
+/*
+IDA* search for optimal face turn metric solutions, with the maximum of the corner and the two edge pattern
+databases as heuristic. The databases are memory mapped from the files written by pdbgen.
+*/
+class OptimalSolver
+{
+    private:
+        struct Prefix
+        {
+            PatternCoords coords;
+            int moves[OPTIMAL_SPLIT_DEPTH];
+            int lastFace;
+        };
+
+        PatternDatabase m_Databases[PATTERN_KIND_COUNT];
+
+        std::atomic<bool> m_Cancel{ false };
+        // Lowest work item that found a solution in the current iteration
+        std::atomic<int> m_BestItem{ 0 };
+        std::atomic<unsigned long long> m_Nodes{ 0 };
+
+        // Background solve started from the keyboard
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        bool m_Solving = false;
+        bool m_HasSolution = false;
+        std::vector<int> m_Solution;
+        std::function<void()> m_OnSolved;
+
+        OptimalSolver() = default;
+        ~OptimalSolver();
+
+        int heuristic(const PatternCoords& coords) const;
+
+        bool search(const PatternCoords& coords, int depth, int bound, int lastFace, int item, int* path, unsigned long long& nodes) const;
+
+        void collectPrefixes(const PatternCoords& coords, int depth, int length, int bound, int lastFace, int* path, std::vector<Prefix>& prefixes) const;
+
+    public:
+        static OptimalSolver &getInstance() {
+            static OptimalSolver instance;
+            return instance;
+        }
+
+        // Map the three pattern databases of a directory, false if any is missing
+        bool load(const std::string& directory);
+        bool isLoaded() const;
+
+        // Shortest solution of the state, false if it isn't solvable, the search was cancelled or exceeded maxDepth.
+        // The first plies are split across `threads` workers (0: one per core), maxDepth is capped at OPTIMAL_MAX_DEPTH.
+        bool solve(const CubeState& state, std::vector<int>& moves, int threads = 0, int maxDepth = OPTIMAL_MAX_DEPTH);
+        void cancel() { m_Cancel = true; }
+
+        // Nodes visited by the last solve
+        unsigned long long getNodeCount() const { return m_Nodes; }
+
+        // Solve on a background thread, the solution is picked up with pollSolution
+        void requestSolve(const CubeState& state);
+        bool pollSolution(std::vector<int>& moves);
+
+        // Called from the solver thread once a solution can be polled, e.g. to wake up an idle main loop
+        void setOnSolved(std::function<void()> onSolved) { m_OnSolved = std::move(onSolved); }
+};
@@ -0,0 +1,328 @@
+#include <PatternDatabase.h>
+
+#include <CubeCoordinates.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+static const int TRACKED_EDGES = 6;
+
+// Bit set words handed to a BFS worker at once (64K states)
+static const uint32_t GENERATE_CHUNK_WORDS = 1024;
+
+/////////////////
+// Coordinates //
+/////////////////
+
+// Ordered slots of the 6 tracked edges, as a partial permutation of the 12 slots
+static uint32_t rankEdgePlacement(const int* slots)
+{
+    uint32_t index = 0;
+    unsigned int used = 0;
+    for(int k = 0; k < TRACKED_EDGES; k++) {
+        int smaller = slots[k] - __builtin_popcount(used & ((1u << slots[k]) - 1));
+        index = index * (EDGE_COUNT - k) + smaller;
+        used |= 1u << slots[k];
+    }
+    return index;
+}
+
+static void unrankEdgePlacement(uint32_t index, int* slots)
+{
+    int digits[TRACKED_EDGES];
+    for(int k = TRACKED_EDGES - 1; k >= 0; k--) {
+        digits[k] = index % (EDGE_COUNT - k);
+        index /= EDGE_COUNT - k;
+    }
+    bool used[EDGE_COUNT] = {};
+    for(int k = 0; k < TRACKED_EDGES; k++) {
+        int slot = 0;
+        for(int skip = digits[k]; used[slot] || skip > 0; slot++) {
+            if(!used[slot]) { skip--; }
+        }
+        used[slot] = true;
+        slots[k] = slot;
+    }
+}
+
+static uint32_t edgeCoordinate(const CubeState& state, int firstPiece)
+{
+    int slots[TRACKED_EDGES];
+    uint32_t flips = 0;
+    for(int slot = 0; slot < EDGE_COUNT; slot++) {
+        int k = state.ep[slot] - firstPiece;
+        if(k < 0 || k >= TRACKED_EDGES) { continue; }
+        slots[k] = slot;
+        flips |= state.eo[slot] << k;
+    }
+    return rankEdgePlacement(slots) * EDGE_FLIPS + flips;
+}
+
+//////////////////
+// PatternMoves //
+//////////////////
+
+PatternMoves::PatternMoves()
+{
+    m_CornerPermutation.resize(CORNER_PERMUTATIONS * MOVE_COUNT);
+    for(uint32_t p = 0; p < CORNER_PERMUTATIONS; p++) {
+        CubeState state = CubeState::solved();
+        UnrankPermutation(p, state.cp, CORNER_COUNT);
+        for(int m = 0; m < MOVE_COUNT; m++) {
+            m_CornerPermutation[p * MOVE_COUNT + m] = RankPermutation(state.multiply(CubeState::moveState(m)).cp, CORNER_COUNT);
+        }
+    }
+
+    m_CornerTwist.resize(CORNER_TWISTS * MOVE_COUNT);
+    for(uint32_t t = 0; t < CORNER_TWISTS; t++) {
+        CubeState state = CubeState::solved();
+        UnrankOrientation(t, state.co, CORNER_COUNT, 3);
+        for(int m = 0; m < MOVE_COUNT; m++) {
+            m_CornerTwist[t * MOVE_COUNT + m] = RankOrientation(state.multiply(CubeState::moveState(m)).co, CORNER_COUNT, 3);
+        }
+    }
+
+    // Which pieces are tracked doesn't matter, the same table serves both edge halves
+    m_EdgePlacement.resize(EDGE_PLACEMENTS * MOVE_COUNT);
+    for(uint32_t p = 0; p < EDGE_PLACEMENTS; p++) {
+        int slots[TRACKED_EDGES];
+        unrankEdgePlacement(p, slots);
+        CubeState state = CubeState::solved();
+        bool tracked[EDGE_COUNT] = {};
+        for(int k = 0; k < TRACKED_EDGES; k++) {
+            state.ep[slots[k]] = k;
+            tracked[slots[k]] = true;
+        }
+        for(int slot = 0, piece = TRACKED_EDGES; slot < EDGE_COUNT; slot++) {
+            if(!tracked[slot]) { state.ep[slot] = piece++; }
+        }
+        for(int m = 0; m < MOVE_COUNT; m++) {
+            uint32_t index = edgeCoordinate(state.multiply(CubeState::moveState(m)), 0);
+            m_EdgePlacement[p * MOVE_COUNT + m] = (index / EDGE_FLIPS) << 6 | (index % EDGE_FLIPS);
+        }
+    }
+}
+
+PatternCoords PatternMoves::fromState(const CubeState& state) const
+{
+    PatternCoords coords;
+    coords.corners = RankPermutation(state.cp, CORNER_COUNT) * CORNER_TWISTS + RankOrientation(state.co, CORNER_COUNT, 3);
+    coords.edgesLow = edgeCoordinate(state, 0);
+    coords.edgesHigh = edgeCoordinate(state, TRACKED_EDGES);
+    return coords;
+}
+
+/////////////////////
+// PatternDatabase //
+/////////////////////
+
+uint32_t PatternDatabase::getSize(PatternKind kind)
+{
+    return kind == PatternKind::Corners ? CORNER_PERMUTATIONS * CORNER_TWISTS : EDGE_PLACEMENTS * EDGE_FLIPS;
+}
+
+const char* PatternDatabase::getFileName(PatternKind kind)
+{
+    switch(kind) {
+        case PatternKind::Corners:
+            return "corners.pdb";
+        case PatternKind::EdgesLow:
+            return "edges_low.pdb";
+        default:
+            return "edges_high.pdb";
+    }
+}
+
+// FNV-1a over 64-bit words, then over the remaining bytes
+static uint64_t checksum(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    size_t words = size / sizeof(uint64_t);
+    for(size_t w = 0; w < words; w++) {
+        uint64_t word;
+        std::memcpy(&word, data + w * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for(size_t i = words * sizeof(uint64_t); i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool PatternDatabase::load(const std::string& path, PatternKind kind)
+{
+    m_Data = nullptr;
+    if(!m_File.open(path)) { return false; }
+
+    PatternFileHeader header;
+    size_t payload = (getSize(kind) + 1) / 2;
+    const char* error = nullptr;
+    if(m_File.size() < sizeof(header)) {
+        error = "truncated header";
+    } else {
+        std::memcpy(&header, m_File.data(), sizeof(header));
+        if(std::memcmp(header.magic, PATTERN_FILE_MAGIC, sizeof(header.magic)) != 0) {
+            error = "not a pattern database";
+        } else if(header.version != PATTERN_FILE_VERSION) {
+            error = "unsupported version, regenerate it with make pdb";
+        } else if(header.kind != (uint32_t)kind || header.entries != getSize(kind)) {
+            error = "wrong pattern kind";
+        } else if(m_File.size() != sizeof(header) + payload) {
+            error = "wrong size";
+        } else if(header.checksum != checksum(m_File.data() + sizeof(header), payload)) {
+            error = "checksum mismatch";
+        }
+    }
+    if(error) {
+        std::printf("%s: %s\n", path.c_str(), error);
+        m_File.close();
+        return false;
+    }
+
+    m_Data = m_File.data() + sizeof(header);
+    return true;
+}
+
+bool PatternDatabase::save(const std::string& path, PatternKind kind, const std::vector<uint8_t>& table)
+{
+    PatternFileHeader header = {};
+    std::memcpy(header.magic, PATTERN_FILE_MAGIC, sizeof(header.magic));
+    header.version = PATTERN_FILE_VERSION;
+    header.kind = (uint32_t)kind;
+    header.entries = getSize(kind);
+    header.checksum = checksum(table.data(), table.size());
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if(!file) { return false; }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(table.data(), 1, table.size(), file) == table.size();
+    return std::fclose(file) == 0 && written;
+}
+
+/*
+Bit sets with one bit per state, shared by the BFS workers. Bits are only ever set, with atomic or, so
+concurrent updates of the same word never lose a bit.
+*/
+struct StateBits
+{
+    std::vector<uint64_t> words;
+
+    StateBits(uint32_t size)
+        : words((size + 63) / 64, 0) {}
+
+    bool test(uint32_t index) const { return (__atomic_load_n(&words[index >> 6], __ATOMIC_RELAXED) >> (index & 63)) & 1; }
+
+    // True if the bit wasn't set yet
+    bool set(uint32_t index)
+    {
+        uint64_t bit = 1ull << (index & 63);
+        return !(__atomic_fetch_or(&words[index >> 6], bit, __ATOMIC_RELAXED) & bit);
+    }
+
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+};
+
+// Overwrite a nibble that still holds PATTERN_UNKNOWN, the other nibble of the byte may be written concurrently
+static void storeDepth(uint8_t* table, uint32_t index, uint8_t depth)
+{
+    int shift = (index & 1) * 4;
+    __atomic_fetch_and(table + (index >> 1), (uint8_t)~((~depth & 0xF) << shift), __ATOMIC_RELAXED);
+}
+
+/*
+Level synchronous BFS over the coordinate space. Every level is split into chunks of the bit sets that the
+workers take one at a time. Early levels expand the frontier forward; once fewer states are unvisited than
+in the frontier, the unvisited states look backward for a neighbor in the frontier instead (moves come with
+their inverses). Memory: half a byte per state for the table plus three bits for visited, frontier and next.
+*/
+std::vector<uint8_t> PatternDatabase::generate(PatternKind kind, int threads, bool verbose)
+{
+    const PatternMoves& moves = PatternMoves::getInstance();
+    uint32_t size = getSize(kind);
+    std::vector<uint8_t> table((size + 1) / 2, 0xFF);
+    uint8_t* data = table.data();
+    StateBits visited(size), frontier(size), next(size);
+    uint32_t wordCount = (uint32_t)visited.words.size();
+
+    if(threads <= 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    if(verbose) {
+        double megabytes = (table.size() + 3 * wordCount * sizeof(uint64_t)) / (1024.0 * 1024.0);
+        std::printf("  %d workers, %.0f MB\n", threads, megabytes);
+    }
+
+    uint32_t solved = moves.fromState(CubeState::solved()).get(kind);
+    visited.set(solved);
+    frontier.set(solved);
+    storeDepth(data, solved, 0);
+    uint64_t total = 1, frontierSize = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint8_t depth = 0; depth + 1 < PATTERN_UNKNOWN && frontierSize > 0; depth++) {
+        bool backward = frontierSize > size - total;
+        std::atomic<uint32_t> nextChunk(0);
+        std::atomic<uint64_t> found(0);
+
+        auto expand = [&]() {
+            uint64_t claimed = 0;
+            for(;;) {
+                uint32_t begin = nextChunk.fetch_add(1) * GENERATE_CHUNK_WORDS;
+                if(begin >= wordCount) { break; }
+                uint32_t end = std::min(begin + GENERATE_CHUNK_WORDS, wordCount);
+                for(uint32_t w = begin; w < end; w++) {
+                    uint64_t bits = backward ? ~visited.words[w] : frontier.words[w];
+                    while(bits) {
+                        uint32_t i = w * 64 + __builtin_ctzll(bits);
+                        bits &= bits - 1;
+                        if(i >= size) { break; }
+
+                        if(backward) {
+                            // Only this worker writes the states of its chunk
+                            for(int m = 0; m < MOVE_COUNT; m++) {
+                                if(!frontier.test(moves.move(kind, i, m))) { continue; }
+                                visited.set(i);
+                                next.set(i);
+                                storeDepth(data, i, depth + 1);
+                                claimed++;
+                                break;
+                            }
+                        } else {
+                            for(int m = 0; m < MOVE_COUNT; m++) {
+                                uint32_t neighbor = moves.move(kind, i, m);
+                                if(visited.test(neighbor) || !visited.set(neighbor)) { continue; }
+                                next.set(neighbor);
+                                storeDepth(data, neighbor, depth + 1);
+                                claimed++;
+                            }
+                        }
+                    }
+                }
+            }
+            found += claimed;
+        };
+
+        std::vector<std::thread> workers;
+        for(int t = 1; t < threads; t++) {
+            workers.emplace_back(expand);
+        }
+        expand();
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+
+        std::swap(frontier, next);
+        next.clear();
+        frontierSize = found;
+        total += found;
+        if(verbose) {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  depth %2d: %10llu states (%llu / %u) %s %.1fs\n", depth + 1, (unsigned long long)frontierSize,
+                (unsigned long long)total, size, backward ? "backward" : "forward", seconds);
+        }
+    }
+    return table;
+}
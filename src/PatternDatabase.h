@@ -0,0 +1,123 @@
+#pragma once
+
+#include <CubeState.h>
+#include <MappedFile.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t CORNER_PERMUTATIONS = 40320;  // 8!
+static constexpr uint32_t CORNER_TWISTS = 2187;         // 3^7
+static constexpr uint32_t EDGE_PLACEMENTS = 665280;     // 12! / 6!, where 6 edges are
+static constexpr uint32_t EDGE_FLIPS = 64;              // 2^6
+
+// Distance stored in a nibble before the state was reached
+static constexpr uint8_t PATTERN_UNKNOWN = 0xF;
+
+/*
+The three abstractions of the cube used as IDA* heuristics:
+    Corners:   permutation and twist of the 8 corners
+    EdgesLow:  where the edges UR, UF, UL, UB, DR, DF are and their flips
+    EdgesHigh: the same for DL, DB, FR, FL, BL, BR
+*/
+enum class PatternKind
+{
+    Corners,
+    EdgesLow,
+    EdgesHigh
+};
+
+static constexpr int PATTERN_KIND_COUNT = 3;
+
+static constexpr char PATTERN_FILE_MAGIC[8] = { 'C', 'U', 'B', 'E', 'P', 'D', 'B', '\0' };
+static constexpr uint32_t PATTERN_FILE_VERSION = 1;
+
+// Header of a pattern database file, followed by the nibble table (two states per byte, low nibble first)
+struct PatternFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;       // PatternKind
+    uint64_t entries;    // number of states
+    uint64_t checksum;   // of the table, see PatternDatabase.cpp
+    uint64_t reserved[4];
+};
+
+// Position of a state in all three pattern spaces, updated move by move through PatternMoves
+struct PatternCoords
+{
+    uint32_t corners;    // permutation * CORNER_TWISTS + twist
+    uint32_t edgesLow;   // placement * EDGE_FLIPS + flips
+    uint32_t edgesHigh;
+
+    uint32_t get(PatternKind kind) const
+    {
+        return kind == PatternKind::Corners ? corners : (kind == PatternKind::EdgesLow ? edgesLow : edgesHigh);
+    }
+};
+
+// Coordinate move tables, built once on first use (~50 MB)
+class PatternMoves
+{
+    private:
+        std::vector<uint16_t> m_CornerPermutation;  // [permutation][move]
+        std::vector<uint16_t> m_CornerTwist;        // [twist][move]
+        // [placement][move] = new placement << 6 | flips toggled by the move
+        std::vector<uint32_t> m_EdgePlacement;
+
+        PatternMoves();
+
+    public:
+        static PatternMoves &getInstance() {
+            static PatternMoves instance;
+            return instance;
+        }
+
+        PatternCoords fromState(const CubeState& state) const;
+
+        uint32_t moveCorners(uint32_t index, int move) const
+        {
+            return m_CornerPermutation[(index / CORNER_TWISTS) * MOVE_COUNT + move] * CORNER_TWISTS
+                + m_CornerTwist[(index % CORNER_TWISTS) * MOVE_COUNT + move];
+        }
+
+        uint32_t moveEdges(uint32_t index, int move) const
+        {
+            uint32_t entry = m_EdgePlacement[(index / EDGE_FLIPS) * MOVE_COUNT + move];
+            return (entry >> 6) * EDGE_FLIPS + ((index % EDGE_FLIPS) ^ (entry & 0x3F));
+        }
+
+        uint32_t move(PatternKind kind, uint32_t index, int move) const
+        {
+            return kind == PatternKind::Corners ? moveCorners(index, move) : moveEdges(index, move);
+        }
+
+        PatternCoords apply(const PatternCoords& coords, int move) const
+        {
+            return { moveCorners(coords.corners, move), moveEdges(coords.edgesLow, move), moveEdges(coords.edgesHigh, move) };
+        }
+};
+
+// Exact distances to solved in one pattern space, 4 bits per state
+class PatternDatabase
+{
+    private:
+        MappedFile m_File;
+        const uint8_t* m_Data = nullptr;
+
+    public:
+        // Number of states of a pattern space
+        static uint32_t getSize(PatternKind kind);
+        static const char* getFileName(PatternKind kind);
+
+        // Map a file written by pdbgen read-only, false when it is missing, of another version or corrupted
+        bool load(const std::string& path, PatternKind kind);
+        static bool save(const std::string& path, PatternKind kind, const std::vector<uint8_t>& table);
+        bool isLoaded() const { return m_Data != nullptr; }
+
+        int get(uint32_t index) const { return (m_Data[index >> 1] >> ((index & 1) * 4)) & 0xF; }
+
+        // Parallel breadth-first search from solved with `threads` workers (0: one per core)
+        static std::vector<uint8_t> generate(PatternKind kind, int threads, bool verbose);
+};
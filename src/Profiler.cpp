@@ -0,0 +1,194 @@
+#include <Profiler.h>
+
+#include <algorithm>
+#include <cmath>
+
+struct Percentiles
+{
+    double p50, p95, p99, mean, max;
+};
+
+// Nearest-rank percentiles, ignoring negative (missing) values
+static Percentiles computePercentiles(std::vector<double> values)
+{
+    values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return v < 0.0; }), values.end());
+    Percentiles result = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if(values.empty()) { return result; }
+
+    std::sort(values.begin(), values.end());
+    auto rank = [&values](double p) {
+        size_t r = (size_t)std::ceil(p / 100.0 * values.size());
+        return values[std::min(values.size() - 1, r > 0 ? r - 1 : 0)];
+    };
+    result.p50 = rank(50.0);
+    result.p95 = rank(95.0);
+    result.p99 = rank(99.0);
+    result.max = values.back();
+    for(double v : values) {
+        result.mean += v;
+    }
+    result.mean /= values.size();
+    return result;
+}
+
+Profiler::Profiler()
+{
+    for(int slot = 0; slot < PROFILER_QUERY_LATENCY; slot++) {
+        m_QueryFrame[slot] = -1;
+    }
+}
+
+void Profiler::readQueries(int slot)
+{
+    if(m_QueryFrame[slot] < 0) { return; }
+
+    GLuint64 begin = 0, end = 0;
+    GLCall(glGetQueryObjectui64v(m_Queries[slot][0], GL_QUERY_RESULT, &begin));
+    GLCall(glGetQueryObjectui64v(m_Queries[slot][1], GL_QUERY_RESULT, &end));
+    if(m_QueryFrame[slot] < (int)m_Frames.size()) {
+        m_Frames[m_QueryFrame[slot]].gpuMilliseconds = (double)(end - begin) * 1e-6;
+    }
+
+    for(int pass = 0; pass < (int)m_PassNames.size(); pass++) {
+        if(!m_PassIssued[slot][pass]) { continue; }
+        GLCall(glGetQueryObjectui64v(m_PassQueries[slot][pass][0], GL_QUERY_RESULT, &begin));
+        GLCall(glGetQueryObjectui64v(m_PassQueries[slot][pass][1], GL_QUERY_RESULT, &end));
+        if(m_QueryFrame[slot] < (int)m_Frames.size()) {
+            m_Frames[m_QueryFrame[slot]].passMilliseconds[pass] = (double)(end - begin) * 1e-6;
+        }
+        m_PassIssued[slot][pass] = false;
+    }
+    m_QueryFrame[slot] = -1;
+}
+
+void Profiler::beginFrame()
+{
+    m_FrameStart = std::chrono::steady_clock::now();
+    m_DrawCalls = 0;
+    m_Triangles = 0;
+
+    if(!m_Recording) { return; }
+
+    // Queries are created with the first recorded frame, when a context is surely current
+    if(m_Queries[0][0] == 0) {
+        GLCall(glGenQueries(2 * PROFILER_QUERY_LATENCY, &m_Queries[0][0]));
+        GLCall(glGenQueries(2 * PROFILER_QUERY_LATENCY * PROFILER_MAX_PASSES, &m_PassQueries[0][0][0]));
+    }
+
+    // Reuse the slot of the frame PROFILER_QUERY_LATENCY frames ago, its result is available by now
+    int slot = (int)m_Frames.size() % PROFILER_QUERY_LATENCY;
+    readQueries(slot);
+    GLCall(glQueryCounter(m_Queries[slot][0], GL_TIMESTAMP));
+    m_QueryFrame[slot] = (int)m_Frames.size();
+}
+
+void Profiler::endFrame()
+{
+    if(!m_Recording) { return; }
+
+    int slot = (int)m_Frames.size() % PROFILER_QUERY_LATENCY;
+    GLCall(glQueryCounter(m_Queries[slot][1], GL_TIMESTAMP));
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_FrameStart;
+    FrameRecord frame = { elapsed.count(), -1.0, m_DrawCalls, m_Triangles, {} };
+    std::fill(frame.passMilliseconds, frame.passMilliseconds + PROFILER_MAX_PASSES, -1.0);
+    m_Frames.push_back(frame);
+}
+
+int Profiler::registerPass(const char* name)
+{
+    if((int)m_PassNames.size() == PROFILER_MAX_PASSES) { return -1; }
+
+    m_PassNames.push_back(name);
+    return (int)m_PassNames.size() - 1;
+}
+
+void Profiler::beginPass(int pass)
+{
+    if(!m_Recording || pass < 0) { return; }
+
+    int slot = (int)m_Frames.size() % PROFILER_QUERY_LATENCY;
+    GLCall(glQueryCounter(m_PassQueries[slot][pass][0], GL_TIMESTAMP));
+}
+
+void Profiler::endPass(int pass)
+{
+    if(!m_Recording || pass < 0) { return; }
+
+    int slot = (int)m_Frames.size() % PROFILER_QUERY_LATENCY;
+    GLCall(glQueryCounter(m_PassQueries[slot][pass][1], GL_TIMESTAMP));
+    m_PassIssued[slot][pass] = true;
+}
+
+void Profiler::finish()
+{
+    for(int slot = 0; slot < PROFILER_QUERY_LATENCY; slot++) {
+        readQueries(slot);
+    }
+}
+
+void Profiler::printReport(FILE* file) const
+{
+    std::vector<double> cpu, gpu, drawCalls, triangles;
+    for(const FrameRecord& frame : m_Frames) {
+        cpu.push_back(frame.cpuMilliseconds);
+        gpu.push_back(frame.gpuMilliseconds);
+        drawCalls.push_back(frame.drawCalls);
+        triangles.push_back((double)frame.triangles);
+    }
+
+    Percentiles c = computePercentiles(cpu), g = computePercentiles(gpu);
+    Percentiles d = computePercentiles(drawCalls), t = computePercentiles(triangles);
+    fprintf(file, "Frames: %zu\n", m_Frames.size());
+    fprintf(file, "%-22s %10s %10s %10s %10s %10s\n", "", "p50", "p95", "p99", "mean", "max");
+    fprintf(file, "%-22s %10.3f %10.3f %10.3f %10.3f %10.3f\n", "Frame time (ms)", c.p50, c.p95, c.p99, c.mean, c.max);
+    fprintf(file, "%-22s %10.3f %10.3f %10.3f %10.3f %10.3f\n", "GPU time (ms)", g.p50, g.p95, g.p99, g.mean, g.max);
+    fprintf(file, "%-22s %10.0f %10.0f %10.0f %10.1f %10.0f\n", "Draw calls / frame", d.p50, d.p95, d.p99, d.mean, d.max);
+    fprintf(file, "%-22s %10.0f %10.0f %10.0f %10.1f %10.0f\n", "Triangles / frame", t.p50, t.p95, t.p99, t.mean, t.max);
+
+    for(int pass = 0; pass < (int)m_PassNames.size(); pass++) {
+        std::vector<double> times;
+        for(const FrameRecord& frame : m_Frames) {
+            times.push_back(frame.passMilliseconds[pass]);
+        }
+        Percentiles p = computePercentiles(times);
+        std::string label = m_PassNames[pass] + " GPU (ms)";
+        fprintf(file, "%-22s %10.3f %10.3f %10.3f %10.3f %10.3f\n", label.c_str(), p.p50, p.p95, p.p99, p.mean, p.max);
+    }
+}
+
+bool Profiler::writeJson(const char* path, const char* label) const
+{
+    FILE* file = fopen(path, "w");
+    if(!file) {
+        std::cout << "Warning: failed to open " << path << " for the profiler report" << std::endl;
+        return false;
+    }
+
+    std::vector<double> cpu, gpu;
+    double drawCalls = 0.0, triangles = 0.0;
+    for(const FrameRecord& frame : m_Frames) {
+        cpu.push_back(frame.cpuMilliseconds);
+        gpu.push_back(frame.gpuMilliseconds);
+        drawCalls += frame.drawCalls;
+        triangles += (double)frame.triangles;
+    }
+    Percentiles c = computePercentiles(cpu), g = computePercentiles(gpu);
+    double frames = std::max<double>(1.0, (double)m_Frames.size());
+
+    fprintf(file, "{\n  \"label\": \"%s\",\n  \"frames\": %zu,\n", label, m_Frames.size());
+    fprintf(file, "  \"frame_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"mean\": %.4f, \"max\": %.4f},\n", c.p50, c.p95, c.p99, c.mean, c.max);
+    fprintf(file, "  \"gpu_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"mean\": %.4f, \"max\": %.4f},\n", g.p50, g.p95, g.p99, g.mean, g.max);
+    for(int pass = 0; pass < (int)m_PassNames.size(); pass++) {
+        std::vector<double> times;
+        for(const FrameRecord& frame : m_Frames) {
+            times.push_back(frame.passMilliseconds[pass]);
+        }
+        Percentiles p = computePercentiles(times);
+        fprintf(file, "  \"%s_gpu_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"mean\": %.4f, \"max\": %.4f},\n",
+            m_PassNames[pass].c_str(), p.p50, p.p95, p.p99, p.mean, p.max);
+    }
+    fprintf(file, "  \"draw_calls_per_frame\": %.2f,\n  \"triangles_per_frame\": %.2f\n}\n", drawCalls / frames, triangles / frames);
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Debugger.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Frames in flight before a GPU timestamp is read back, so reading never stalls the pipeline
+static constexpr int PROFILER_QUERY_LATENCY = 4;
+// Named GPU passes timed inside a frame
+static constexpr int PROFILER_MAX_PASSES = 4;
+
+struct FrameRecord
+{
+    double cpuMilliseconds;
+    // Negative until the GPU timestamps of the frame were read back
+    double gpuMilliseconds;
+    unsigned int drawCalls;
+    unsigned long long triangles;
+    // GPU time of every registered pass, negative when it didn't run or wasn't read back yet
+    double passMilliseconds[PROFILER_MAX_PASSES];
+};
+
+// Collects per-frame CPU time, GPU time (timestamp queries), draw calls and triangles
+class Profiler
+{
+    private:
+        bool m_Recording = false;
+        std::vector<FrameRecord> m_Frames;
+
+        std::chrono::steady_clock::time_point m_FrameStart;
+        unsigned int m_DrawCalls = 0;
+        unsigned long long m_Triangles = 0;
+
+        // Begin and end timestamp queries of the last frames, -1 when a slot holds no pending frame
+        unsigned int m_Queries[PROFILER_QUERY_LATENCY][2] = {};
+        int m_QueryFrame[PROFILER_QUERY_LATENCY];
+
+        std::vector<std::string> m_PassNames;
+        unsigned int m_PassQueries[PROFILER_QUERY_LATENCY][PROFILER_MAX_PASSES][2] = {};
+        bool m_PassIssued[PROFILER_QUERY_LATENCY][PROFILER_MAX_PASSES] = {};
+
+        Profiler();
+
+        void readQueries(int slot);
+
+    public:
+        static Profiler &getInstance() {
+            static Profiler instance;
+            return instance;
+        }
+
+        // Only recorded frames are kept, counters are updated either way
+        void setRecording(bool recording) { m_Recording = recording; }
+        // Room for the records of `frames` frames, so recording them doesn't allocate
+        void reserve(size_t frames) { m_Frames.reserve(frames); }
+        bool isRecording() const { return m_Recording; }
+
+        void beginFrame();
+        void endFrame();
+
+        // Time a part of the frame on the GPU, e.g. a post-processing pass. Returns -1 when too many are registered
+        int registerPass(const char* name);
+        void beginPass(int pass);
+        void endPass(int pass);
+
+        // Called by the Renderer for every draw call
+        void addDrawCall(unsigned long long triangles) { m_DrawCalls++; m_Triangles += triangles; }
+
+        // Wait for the GPU timestamps of all recorded frames
+        void finish();
+
+        const std::vector<FrameRecord>& getFrames() const { return m_Frames; }
+        unsigned int getDrawCalls() const { return m_DrawCalls; }
+        unsigned long long getTriangles() const { return m_Triangles; }
+
+        // Frame time, GPU time, draw call and triangle summary with p50/p95/p99 percentiles
+        void printReport(FILE* file) const;
+        bool writeJson(const char* path, const char* label) const;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+// xoshiro256** by Blackman and Vigna, seeded through splitmix64. Fast, 2^256 - 1 period, not cryptographic.
+class Xoshiro256
+{
+    private:
+        uint64_t m_State[4];
+
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    public:
+        explicit Xoshiro256(uint64_t seed)
+        {
+            for(uint64_t& word : m_State) {
+                seed += 0x9e3779b97f4a7c15ull;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        uint64_t next()
+        {
+            uint64_t result = rotl(m_State[1] * 5, 7) * 9;
+            uint64_t t = m_State[1] << 17;
+            m_State[2] ^= m_State[0];
+            m_State[3] ^= m_State[1];
+            m_State[1] ^= m_State[2];
+            m_State[0] ^= m_State[3];
+            m_State[2] ^= t;
+            m_State[3] = rotl(m_State[3], 45);
+            return result;
+        }
+
+        // Unbiased integer in [0, bound), Lemire's multiply and reject
+        uint32_t below(uint32_t bound)
+        {
+            uint64_t product = (uint64_t)(uint32_t)(next() >> 32) * bound;
+            if((uint32_t)product < bound) {
+                uint32_t threshold = (0u - bound) % bound;
+                while((uint32_t)product < threshold) {
+                    product = (uint64_t)(uint32_t)(next() >> 32) * bound;
+                }
+            }
+            return (uint32_t)(product >> 32);
+        }
+};
@@ -0,0 +1,169 @@
+#include <RenderBenchmark.h>
+
+#include <AllocationCounter.h>
+#include <FrameArena.h>
+#include <Notation.h>
+#include <Profiler.h>
+#include <RenderState.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+const float BENCHMARK_FOV = 45.0f;
+
+// Faces turned by the move script, repeated for the whole run
+const int MOVE_SCRIPT[] = { 3, 4, 3, 4, 3, 4, 0, 1, 2, 5, 5, 2, 1, 0, 4, 4, 3, 3 };
+const int MOVE_SCRIPT_LENGTH = sizeof(MOVE_SCRIPT) / sizeof(MOVE_SCRIPT[0]);
+
+// Frames whose allocations aren't counted, buffers and caches fill up during them
+const int ALLOCATION_WARMUP_FRAMES = 10;
+
+bool ParseRenderBenchmarkOptions(int argc, char* argv[], RenderBenchmarkOptions& options)
+{
+    for(int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if(!strcmp(argv[i], "--benchmark") && hasValue) {
+            options.frames = atoi(argv[++i]);
+        } else if(!strcmp(argv[i], "--strategy") && hasValue) {
+            const char* strategy = argv[++i];
+            if(!strcmp(strategy, "per-cubie")) {
+                options.strategy = RenderStrategy::PerCubie;
+            } else if(!strcmp(strategy, "instanced")) {
+                options.strategy = RenderStrategy::Instanced;
+            } else {
+                std::cout << "Unknown strategy: " << strategy << std::endl;
+                return false;
+            }
+        } else if(!strcmp(argv[i], "--puzzles") && hasValue) {
+            options.puzzles = std::max(1, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--move-period") && hasValue) {
+            options.movePeriod = std::max(1, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--json") && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if(!strcmp(argv[i], "--moves") && hasValue) {
+            options.moves = argv[++i];
+            Algorithm algorithm;
+            std::string error;
+            if(!Algorithm::compile(options.moves, algorithm, &error)) {
+                std::cout << "Invalid moves: " << error << std::endl;
+                return false;
+            }
+        } else if(!strcmp(argv[i], "--record") && hasValue) {
+            options.recordPath = argv[++i];
+        } else if(!strcmp(argv[i], "--replay") && hasValue) {
+            options.replayPath = argv[++i];
+        } else if(!strcmp(argv[i], "--replay-speed") && hasValue) {
+            options.replaySpeed = std::max(0.0f, (float)atof(argv[++i]));
+        } else if(!strcmp(argv[i], "--swap-interval") && hasValue) {
+            options.swapInterval = std::max(-1, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--no-state-cache")) {
+            options.stateCache = false;
+        } else if(!strcmp(argv[i], "--msaa") && hasValue) {
+            options.msaaSamples = std::max(0, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--fxaa")) {
+            options.fxaa = true;
+        } else if(!strcmp(argv[i], "--lights") && hasValue) {
+            options.lights = std::max(0, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--float-vertices")) {
+            options.packedVertices = false;
+        } else if(!strcmp(argv[i], "--no-ssao")) {
+            options.ssao = false;
+        } else if(!strcmp(argv[i], "--xray")) {
+            options.xRay = true;
+        } else if(!strcmp(argv[i], "--transparency") && hasValue) {
+            const char* transparency = argv[++i];
+            if(!strcmp(transparency, "oit")) {
+                options.transparency = TransparencyMode::WeightedBlended;
+            } else if(!strcmp(transparency, "sorted")) {
+                options.transparency = TransparencyMode::Sorted;
+            } else {
+                std::cout << "Unknown transparency: " << transparency << std::endl;
+                return false;
+            }
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--benchmark <frames>] [--strategy per-cubie|instanced]"
+                << " [--puzzles <n>] [--move-period <frames>] [--json <file>] [--moves <sequence>]"
+                << " [--record <file>] [--replay <file>] [--replay-speed <x>]"
+                << " [--swap-interval <n>] [--no-state-cache] [--msaa <samples>] [--fxaa]"
+                << " [--lights <n>] [--no-ssao] [--xray] [--transparency oit|sorted]"
+                << " [--float-vertices]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void RenderBenchmark::start(Camera& camera, CubeRenderer& renderer, RubiksCube& cube)
+{
+    renderer.setStrategy(m_Options.strategy);
+    renderer.setPuzzleCount(m_Options.puzzles);
+    renderer.setLodEnabled(false);
+    m_MeshVertexBytes = renderer.getMeshVertexBytes();
+    m_MeshIndexBytes = renderer.getMeshIndexBytes();
+
+    // Keep the whole scene in view and inside the clipping planes for the whole orbit
+    float radius = renderer.getSceneRadius();
+    m_CameraDistance = radius / glm::sin(glm::radians(BENCHMARK_FOV * 0.5f)) * 1.1f;
+    camera.setPerspective(BENCHMARK_FOV, 0.1f, m_CameraDistance + 2.0f * radius);
+
+    cube.reset();
+    m_Frame = 0;
+    Profiler::getInstance().setRecording(true);
+    Profiler::getInstance().reserve(m_Options.frames);
+    RenderState::getInstance().resetCounters();
+}
+
+void RenderBenchmark::prepareFrame(Camera& camera, RubiksCube& cube)
+{
+    // One full orbit over the run, bobbing up and down twice
+    float t = (float)m_Frame / (float)m_Options.frames;
+    float azimuth = glm::two_pi<float>() * t;
+    float elevation = 0.35f * glm::sin(2.0f * azimuth);
+    glm::vec3 position = m_CameraDistance * glm::vec3(
+        glm::sin(azimuth) * glm::cos(elevation),
+        glm::sin(elevation),
+        glm::cos(azimuth) * glm::cos(elevation));
+    camera.lookAt(position, glm::vec3(0.0f));
+
+    if(m_Frame % m_Options.movePeriod == 0) {
+        cube.rotateFace(MOVE_SCRIPT[(m_Frame / m_Options.movePeriod) % MOVE_SCRIPT_LENGTH]);
+    }
+
+    // The last frame isn't drawn yet, the count covers the frames in between
+    if(m_Frame == ALLOCATION_WARMUP_FRAMES) {
+        m_AllocationsAtWarmup = AllocationCounter::getCount();
+    }
+    if(m_Frame == m_Options.frames - 1) {
+        m_AllocationsAtEnd = AllocationCounter::getCount();
+    }
+    m_Frame++;
+}
+
+void RenderBenchmark::report() const
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.finish();
+
+    const char* strategy = m_Options.strategy == RenderStrategy::Instanced ? "instanced" : "per-cubie";
+    printf("Render benchmark: %s, %d puzzle(s), renderer %s\n", strategy, m_Options.puzzles, glGetString(GL_RENDERER));
+    profiler.printReport(stdout);
+    RenderState::getInstance().printReport(stdout);
+
+    unsigned int cubies = 27 * m_Options.puzzles;
+    printf("Cubie mesh: %u bytes of vertices, %u bytes of indices, %.1f KiB read per frame for %u cubies\n",
+        m_MeshVertexBytes, m_MeshIndexBytes, (double)(m_MeshVertexBytes + m_MeshIndexBytes) * cubies / 1024.0, cubies);
+
+    int counted = m_Options.frames - 1 - ALLOCATION_WARMUP_FRAMES;
+    if(counted > 0) {
+        printf("Heap allocations after %d warm-up frames: %llu over %d frames, frame arena %zu KiB (high water %zu KiB)\n",
+            ALLOCATION_WARMUP_FRAMES, m_AllocationsAtEnd - m_AllocationsAtWarmup, counted,
+            FrameArena::getInstance().getCapacity() / 1024, FrameArena::getInstance().getHighWater() / 1024);
+    }
+
+    if(!m_Options.jsonPath.empty()) {
+        profiler.writeJson(m_Options.jsonPath.c_str(), strategy);
+    }
+}
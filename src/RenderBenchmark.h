@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Camera.h>
+#include <CubeRenderer.h>
+
+#include "RubiksCube.h"
+
+#include <string>
+
+/*
+Command line of the render benchmark:
+    --benchmark <frames>            render <frames> frames with a fixed camera path and move script, then exit
+    --strategy per-cubie|instanced  how the cubies are drawn (default per-cubie)
+    --puzzles <n>                   number of copies of the cube on screen (default 1)
+    --move-period <frames>          frames between two moves of the script (default 10)
+    --json <file>                   also write the report as JSON
+    --moves <sequence>              apply a sequence in WCA notation to the cube at startup, see Notation.h
+    --record <file>                 record the moves and cubie drags to a replay file, see Replay.h
+    --replay <file>                 play a replay file, hold [ or ] to scrub through it
+    --replay-speed <x>              playback speed of the replay (default 1)
+    --swap-interval <n>             refreshes per frame, 0 for no vsync, -1 for adaptive vsync (default 1)
+    --no-state-cache                send every bind to GL, even when the object is already bound, see RenderState.h
+    --msaa <samples>                multisampling of the scene, 0 or 1 to disable (default 4), see AntiAliasing.h
+    --fxaa                          smooth the remaining edges with an FXAA pass
+    --lights <n>                    point lights around the scene (default 4), see Lighting.h
+    --no-ssao                       start with the ambient occlusion off, G toggles it, see AmbientOcclusion.h
+    --xray                          start with see-through cubies, X toggles them, see Transparency.h
+    --transparency oit|sorted       how see-through cubies blend (default oit, sorted when OIT isn't supported)
+    --float-vertices                upload the cubie mesh as 44-byte float vertices and 32-bit indices, see CubeMesh.h
+*/
+struct RenderBenchmarkOptions
+{
+    int frames = 0;
+    RenderStrategy strategy = RenderStrategy::PerCubie;
+    int puzzles = 1;
+    int movePeriod = 10;
+    std::string jsonPath;
+    std::string moves;
+    std::string recordPath;
+    std::string replayPath;
+    float replaySpeed = 1.0f;
+    int swapInterval = 1;
+    bool stateCache = true;
+    int msaaSamples = 4;
+    bool fxaa = false;
+    int lights = 4;
+    bool ssao = true;
+    bool xRay = false;
+    TransparencyMode transparency = TransparencyMode::WeightedBlended;
+    bool packedVertices = true;
+};
+
+// Parse the benchmark options, prints the usage and returns false on unknown arguments or invalid moves
+bool ParseRenderBenchmarkOptions(int argc, char* argv[], RenderBenchmarkOptions& options);
+
+// Deterministic headless benchmark: vsync off, the same camera path and move script for every run
+class RenderBenchmark
+{
+    private:
+        RenderBenchmarkOptions m_Options;
+        int m_Frame = 0;
+        float m_CameraDistance = 8.0f;
+
+        // Heap allocations counted over the frames after the warm-up, which should have none
+        unsigned long long m_AllocationsAtWarmup = 0;
+        unsigned long long m_AllocationsAtEnd = 0;
+
+        // Cubie mesh bytes read for every cubie drawn
+        unsigned int m_MeshVertexBytes = 0;
+        unsigned int m_MeshIndexBytes = 0;
+
+    public:
+        RenderBenchmark(const RenderBenchmarkOptions& options)
+            : m_Options(options) {};
+
+        bool isActive() const { return m_Options.frames > 0; }
+        bool isDone() const { return m_Frame >= m_Options.frames; }
+
+        // Configure the renderer, reset the cube and start recording frames
+        void start(Camera& camera, CubeRenderer& renderer, RubiksCube& cube);
+
+        // Move the camera along its path and apply the move script for the next frame
+        void prepareFrame(Camera& camera, RubiksCube& cube);
+
+        // Print the frame time percentiles, draw calls, triangles, GPU time, redundant binds, allocations and mesh sizes
+        void report() const;
+};
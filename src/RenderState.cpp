@@ -0,0 +1,128 @@
+#include <RenderState.h>
+
+static const char* BINDING_NAMES[(int)RenderBinding::Count] = { "programs", "vertex arrays", "index buffers", "textures" };
+
+RenderState::RenderState()
+{
+    invalidate();
+}
+
+bool RenderState::track(RenderBinding binding, unsigned int& bound, unsigned int id)
+{
+    m_Binds[(int)binding]++;
+    if(bound == id) {
+        m_Redundant[(int)binding]++;
+        if(m_Caching) { return false; }
+    }
+    bound = id;
+    return true;
+}
+
+void RenderState::useProgram(unsigned int id)
+{
+    if(track(RenderBinding::Program, m_Program, id)) {
+        GLCall(glUseProgram(id));
+    }
+}
+
+void RenderState::bindVertexArray(unsigned int id)
+{
+    if(track(RenderBinding::VertexArray, m_VertexArray, id)) {
+        GLCall(glBindVertexArray(id));
+    }
+}
+
+void RenderState::bindIndexBuffer(unsigned int id)
+{
+    // Unknown vertex array: whatever it has bound is unknown as well
+    unsigned int unknown = UNKNOWN;
+    unsigned int& bound = m_VertexArray == UNKNOWN ? unknown : m_IndexBuffers.emplace(m_VertexArray, UNKNOWN).first->second;
+    if(track(RenderBinding::IndexBuffer, bound, id)) {
+        GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id));
+    }
+}
+
+void RenderState::bindTexture(unsigned int slot, unsigned int id, unsigned int target)
+{
+    unsigned int unknown = UNKNOWN;
+    unsigned int& bound = slot < RENDER_STATE_TEXTURE_SLOTS ? m_Textures[slot] : unknown;
+    if(!track(RenderBinding::Texture, bound, id)) { return; }
+
+    if(m_ActiveTexture != slot || !m_Caching) {
+        GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+        m_ActiveTexture = slot;
+    }
+    GLCall(glBindTexture(target, id));
+}
+
+void RenderState::setPrimitiveRestart(bool enabled, unsigned int index)
+{
+    if(m_PrimitiveRestart != (unsigned int)enabled || !m_Caching) {
+        if(enabled) {
+            GLCall(glEnable(GL_PRIMITIVE_RESTART));
+        } else {
+            GLCall(glDisable(GL_PRIMITIVE_RESTART));
+        }
+        m_PrimitiveRestart = enabled;
+    }
+    if(enabled && (m_RestartIndex != index || !m_Caching)) {
+        GLCall(glPrimitiveRestartIndex(index));
+        m_RestartIndex = index;
+    }
+}
+
+void RenderState::forget(RenderBinding binding, unsigned int id)
+{
+    switch(binding) {
+        case RenderBinding::Program:
+            if(m_Program == id) { m_Program = UNKNOWN; }
+            break;
+        case RenderBinding::VertexArray:
+            // Deleting the bound vertex array binds vertex array 0
+            if(m_VertexArray == id) { m_VertexArray = 0; }
+            m_IndexBuffers.erase(id);
+            break;
+        case RenderBinding::IndexBuffer:
+            for(auto& indexBuffer : m_IndexBuffers) {
+                if(indexBuffer.second == id) { indexBuffer.second = UNKNOWN; }
+            }
+            break;
+        case RenderBinding::Texture:
+            for(unsigned int& texture : m_Textures) {
+                if(texture == id) { texture = UNKNOWN; }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void RenderState::invalidate()
+{
+    m_Program = UNKNOWN;
+    m_VertexArray = UNKNOWN;
+    m_IndexBuffers.clear();
+    m_ActiveTexture = UNKNOWN;
+    m_PrimitiveRestart = UNKNOWN;
+    m_RestartIndex = UNKNOWN;
+    for(unsigned int& texture : m_Textures) {
+        texture = UNKNOWN;
+    }
+}
+
+void RenderState::resetCounters()
+{
+    for(int i = 0; i < (int)RenderBinding::Count; i++) {
+        m_Binds[i] = 0;
+        m_Redundant[i] = 0;
+    }
+}
+
+void RenderState::printReport(FILE* file) const
+{
+    fprintf(file, "Binds (%s):\n", m_Caching ? "cached" : "not cached");
+    for(int i = 0; i < (int)RenderBinding::Count; i++) {
+        double share = m_Binds[i] ? 100.0 * m_Redundant[i] / m_Binds[i] : 0.0;
+        fprintf(file, "  %-14s %12llu requested, %12llu redundant (%.1f%%)\n", BINDING_NAMES[i], m_Binds[i], m_Redundant[i], share);
+    }
+}
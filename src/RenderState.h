@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Debugger.h>
+
+#include <cstdio>
+#include <unordered_map>
+
+// Texture units tracked by the RenderState, binds to higher units always reach GL
+static constexpr unsigned int RENDER_STATE_TEXTURE_SLOTS = 16;
+
+enum class RenderBinding
+{
+    Program,
+    VertexArray,
+    IndexBuffer,
+    Texture,
+    Count
+};
+
+/*
+Shadow copy of the GL bindings. Shader, VertexArray, IndexBuffer and Texture bind through it, so GL is only called
+when the bound object changes. The element array buffer is part of the vertex array state, it is remembered for
+every vertex array. Code calling GL directly for these bindings has to invalidate() the copy afterwards.
+*/
+class RenderState
+{
+    private:
+        static constexpr unsigned int UNKNOWN = ~0u;
+
+        bool m_Caching = true;
+
+        unsigned int m_Program = UNKNOWN;
+        unsigned int m_VertexArray = UNKNOWN;
+        std::unordered_map<unsigned int, unsigned int> m_IndexBuffers;    // by vertex array
+        unsigned int m_ActiveTexture = UNKNOWN;
+        unsigned int m_Textures[RENDER_STATE_TEXTURE_SLOTS];
+        unsigned int m_PrimitiveRestart = UNKNOWN;     // 0 or 1
+        unsigned int m_RestartIndex = UNKNOWN;
+
+        // Binds requested and the ones skipped because the object was already bound
+        unsigned long long m_Binds[(int)RenderBinding::Count] = {};
+        unsigned long long m_Redundant[(int)RenderBinding::Count] = {};
+
+        RenderState();
+
+        // Count the bind, true when it has to reach GL
+        bool track(RenderBinding binding, unsigned int& bound, unsigned int id);
+
+    public:
+        static RenderState &getInstance() {
+            static RenderState instance;
+            return instance;
+        }
+
+        // Without caching every bind reaches GL, redundant binds are still counted
+        void setCaching(bool caching) { m_Caching = caching; invalidate(); }
+        bool isCaching() const { return m_Caching; }
+
+        void useProgram(unsigned int id);
+        void bindVertexArray(unsigned int id);
+        // Binds to the current vertex array
+        void bindIndexBuffer(unsigned int id);
+        // Textures are tracked by name per slot whatever their target, a name only ever has one target
+        void bindTexture(unsigned int slot, unsigned int id, unsigned int target = GL_TEXTURE_2D);
+
+        // Strips end at `index` when enabled, left disabled for lists whose indices may take any value
+        void setPrimitiveRestart(bool enabled, unsigned int index);
+
+        // Called before deleting an object, its name may be reused by the next one created
+        void forget(RenderBinding binding, unsigned int id);
+        // Forget all bindings, e.g. after they were changed by direct GL calls
+        void invalidate();
+
+        unsigned long long getBindCount(RenderBinding binding) const { return m_Binds[(int)binding]; }
+        unsigned long long getRedundantCount(RenderBinding binding) const { return m_Redundant[(int)binding]; }
+        void resetCounters();
+
+        // Requested and redundant binds of every kind
+        void printReport(FILE* file) const;
+};
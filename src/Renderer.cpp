@@ -0,0 +1,32 @@
+#include <Renderer.h>
+
+#include <Profiler.h>
+#include <RenderState.h>
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader)
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    RenderState::getInstance().setPrimitiveRestart(ib.GetPrimitive() == GL_TRIANGLE_STRIP, ib.GetRestartIndex());
+    GLCall(glDrawElements(ib.GetPrimitive(), ib.GetCount(), ib.GetType(), nullptr));
+    Profiler::getInstance().addDrawCall(ib.GetTriangleCount());
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instances)
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    RenderState::getInstance().setPrimitiveRestart(ib.GetPrimitive() == GL_TRIANGLE_STRIP, ib.GetRestartIndex());
+    GLCall(glDrawElementsInstanced(ib.GetPrimitive(), ib.GetCount(), ib.GetType(), nullptr, instances));
+    Profiler::getInstance().addDrawCall((unsigned long long)ib.GetTriangleCount() * instances);
+}
+
+void Renderer::DrawFullscreen(const VertexArray& va, const Shader& shader)
+{
+    shader.Bind();
+    va.Bind();
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+    Profiler::getInstance().addDrawCall(1);
+}
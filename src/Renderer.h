@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Debugger.h>
+#include <IndexBuffer.h>
+#include <Shader.h>
+#include <VertexArray.h>
+
+// Every draw call goes through the Renderer so that the Profiler can count draw calls and triangles
+class Renderer
+{
+    public:
+        static void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader);
+        static void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instances);
+        // One triangle covering the screen, its vertices are generated by the shader from gl_VertexID
+        static void DrawFullscreen(const VertexArray& va, const Shader& shader);
+};
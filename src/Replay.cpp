@@ -0,0 +1,472 @@
+#include <Replay.h>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// Buffered bytes written to the file at once
+static const size_t FLUSH_SIZE = 64 * 1024;
+static const int CUBIE_COUNT = 27;
+
+// Payload of every event type: varint arguments, then floats
+static const int ARG_COUNTS[(int)ReplayEventType::Count] = { 0, 1, 1, 1, 3, 0, 0, 1, 1, 0 };
+static const int VALUE_COUNTS[(int)ReplayEventType::Count] = { 0, 0, 0, 0, 0, 1, 0, 4, 3, 0 };
+
+static const glm::vec3 CUBE_AXES[6] = { CUBE_X_AXIS, CUBE_Y_AXIS, CUBE_Z_AXIS, -CUBE_X_AXIS, -CUBE_Y_AXIS, -CUBE_Z_AXIS };
+
+static void writeVarint(std::vector<uint8_t>& bytes, uint64_t value)
+{
+    while(value >= 0x80) {
+        bytes.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((uint8_t)value);
+}
+
+static void writeFloat(std::vector<uint8_t>& bytes, float value)
+{
+    uint8_t raw[4];
+    std::memcpy(raw, &value, 4);
+    bytes.insert(bytes.end(), raw, raw + 4);
+}
+
+static bool readVarint(const uint8_t* data, uint64_t end, uint64_t& offset, uint64_t& value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+        if(offset >= end) { return false; }
+        uint8_t byte = data[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) { return true; }
+    }
+    return false;
+}
+
+static bool readFloat(const uint8_t* data, uint64_t end, uint64_t& offset, float& value)
+{
+    if(offset + 4 > end) { return false; }
+    std::memcpy(&value, data + offset, 4);
+    offset += 4;
+    return true;
+}
+
+void ApplyReplayEvent(const ReplayEvent& event, RubiksCube& cube)
+{
+    Cubie* cubes = cube.getCubes();
+    int slot = std::min(std::max(event.args[0], 0), CUBIE_COUNT - 1);
+    switch(event.type) {
+        case ReplayEventType::Reset:
+            cube.reset();
+            break;
+        case ReplayEventType::RotateFace:
+            cube.rotateFace(event.args[0]);
+            break;
+        case ReplayEventType::RotateCube:
+            cube.rotateCube(CUBE_AXES[std::min(std::max(event.args[0], 0), 5)]);
+            break;
+        case ReplayEventType::ApplyMove:
+            cube.applyMove(event.args[0]);
+            break;
+        case ReplayEventType::RotateLayers:
+            cube.rotateLayers(event.args[0] % 3, event.args[1], event.args[2]);
+            break;
+        case ReplayEventType::SetRotationAngle:
+            cube.setRotationAngle(event.values[0]);
+            break;
+        case ReplayEventType::ChangeRotationDirection:
+            cube.changeRotationDirection();
+            break;
+        case ReplayEventType::RotateCubie:
+        {
+            glm::quat rotation(event.values[0], event.values[1], event.values[2], event.values[3]);
+            cubes[slot].rotationMatrix = glm::mat4_cast(rotation) * cubes[slot].rotationMatrix;
+            cube.markChanged();
+            break;
+        }
+        case ReplayEventType::TranslateCubie:
+            cubes[slot].position += glm::vec3(event.values[0], event.values[1], event.values[2]);
+            cube.markChanged();
+            break;
+        default:
+            break;
+    }
+}
+
+////////////
+// Writer //
+////////////
+
+bool ReplayWriter::open(const std::string& path, const RubiksCube& cube)
+{
+    finish(m_LastTime);
+    if(!path.empty()) {
+        m_File = std::fopen(path.c_str(), "wb");
+        if(!m_File) { return false; }
+    }
+    m_Open = true;
+    m_Buffer.clear();
+    m_Flushed = 0;
+    m_LastTime = 0;
+    m_Keyframes.clear();
+
+    ReplayFileHeader header = {};
+    std::memcpy(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_FILE_VERSION;
+    header.keyframeInterval = REPLAY_KEYFRAME_INTERVAL;
+    m_Buffer.insert(m_Buffer.end(), (const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+
+    writeKeyframe(0, cube);
+    return true;
+}
+
+void ReplayWriter::write(const ReplayEvent& event, const RubiksCube& cube)
+{
+    if(!m_Open) { return; }
+
+    uint64_t time = std::max(event.time, m_LastTime);
+    writeVarint(m_Buffer, time - m_LastTime);
+    m_Buffer.push_back((uint8_t)event.type);
+    for(int i = 0; i < ARG_COUNTS[(int)event.type]; i++) {
+        writeVarint(m_Buffer, (uint64_t)std::max(event.args[i], 0));
+    }
+    for(int i = 0; i < VALUE_COUNTS[(int)event.type]; i++) {
+        writeFloat(m_Buffer, event.values[i]);
+    }
+    m_LastTime = time;
+
+    if(++m_SinceKeyframe >= REPLAY_KEYFRAME_INTERVAL) { writeKeyframe(time, cube); }
+    flush();
+}
+
+void ReplayWriter::writeKeyframe(uint64_t time, const RubiksCube& cube)
+{
+    m_Keyframes.push_back({ time, m_Flushed + m_Buffer.size() });
+    m_SinceKeyframe = 0;
+
+    writeVarint(m_Buffer, time - m_LastTime);
+    m_Buffer.push_back((uint8_t)ReplayEventType::Keyframe);
+    writeVarint(m_Buffer, time);
+    writeFloat(m_Buffer, cube.getRawRotationAngle());
+    const Cubie* cubes = cube.getCubes();
+    for(int i = 0; i < CUBIE_COUNT; i++) {
+        writeVarint(m_Buffer, (uint64_t)cubes[i].id);
+        for(int k = 0; k < 3; k++) {
+            writeFloat(m_Buffer, cubes[i].position[k]);
+        }
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 3; row++) {
+                writeFloat(m_Buffer, cubes[i].rotationMatrix[column][row]);
+            }
+        }
+    }
+    m_LastTime = time;
+}
+
+void ReplayWriter::flush()
+{
+    if(!m_File || m_Buffer.size() < FLUSH_SIZE) { return; }
+    std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File);
+    m_Flushed += m_Buffer.size();
+    m_Buffer.clear();
+}
+
+void ReplayWriter::finish(uint64_t duration)
+{
+    if(!m_Open) { return; }
+    m_Open = false;
+
+    ReplayFileFooter footer = {};
+    footer.indexOffset = m_Flushed + m_Buffer.size();
+    footer.keyframeCount = m_Keyframes.size();
+    footer.duration = std::max(duration, m_LastTime);
+    std::memcpy(footer.magic, REPLAY_INDEX_MAGIC, sizeof(footer.magic));
+    m_Buffer.insert(m_Buffer.end(), (const uint8_t*)m_Keyframes.data(), (const uint8_t*)(m_Keyframes.data() + m_Keyframes.size()));
+    m_Buffer.insert(m_Buffer.end(), (const uint8_t*)&footer, (const uint8_t*)&footer + sizeof(footer));
+
+    if(m_File) {
+        std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File);
+        std::fclose(m_File);
+        m_File = nullptr;
+        m_Buffer.clear();
+    }
+}
+
+//////////////
+// Recorder //
+//////////////
+
+uint64_t ReplayRecorder::now() const
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_Start).count();
+}
+
+bool ReplayRecorder::start(const std::string& path)
+{
+    m_Start = std::chrono::steady_clock::now();
+    if(!m_Writer.open(path, RubiksCube::getInstance())) {
+        std::cout << "Can't record the replay to " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ReplayRecorder::stop()
+{
+    m_Writer.finish(now());
+}
+
+void ReplayRecorder::record(ReplayEventType type, int arg)
+{
+    record(type, arg, nullptr, 0);
+}
+
+void ReplayRecorder::record(ReplayEventType type, int arg, const float* values, int valueCount)
+{
+    if(!isRecording()) { return; }
+
+    ReplayEvent event;
+    event.type = type;
+    event.time = now();
+    event.args[0] = arg;
+    std::copy(values, values + std::min(valueCount, 4), event.values);
+    m_Writer.write(event, RubiksCube::getInstance());
+}
+
+////////////
+// Reader //
+////////////
+
+bool ReplayReader::open(const std::string& path)
+{
+    m_Bytes.clear();
+    if(!m_File.open(path)) {
+        std::cout << "Can't read the replay " << path << std::endl;
+        return false;
+    }
+    m_Data = m_File.data();
+    m_Size = m_File.size();
+    if(!parse()) {
+        std::cout << "Not a replay of this version: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayReader::load(const std::vector<uint8_t>& bytes)
+{
+    m_File.close();
+    m_Bytes = bytes;
+    m_Data = m_Bytes.data();
+    m_Size = m_Bytes.size();
+    return parse();
+}
+
+bool ReplayReader::parse()
+{
+    m_Index = nullptr;
+    m_KeyframeCount = 0;
+    m_ScannedIndex.clear();
+
+    ReplayFileHeader header;
+    if(m_Size < sizeof(header)) { return false; }
+    std::memcpy(&header, m_Data, sizeof(header));
+    if(std::memcmp(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic)) || header.version != REPLAY_FILE_VERSION) {
+        return false;
+    }
+
+    ReplayFileFooter footer;
+    bool hasFooter = m_Size >= sizeof(header) + sizeof(footer);
+    if(hasFooter) {
+        std::memcpy(&footer, m_Data + m_Size - sizeof(footer), sizeof(footer));
+        hasFooter = !std::memcmp(footer.magic, REPLAY_INDEX_MAGIC, sizeof(footer.magic)) && footer.keyframeCount > 0
+            && footer.indexOffset >= sizeof(header)
+            && footer.keyframeCount <= (m_Size - sizeof(footer) - footer.indexOffset) / sizeof(ReplayKeyframe)
+            && footer.indexOffset + footer.keyframeCount * sizeof(ReplayKeyframe) + sizeof(footer) == m_Size;
+    }
+    if(!hasFooter) { return buildIndex(); }
+
+    m_Index = m_Data + footer.indexOffset;
+    m_KeyframeCount = footer.keyframeCount;
+    m_End = footer.indexOffset;
+    m_Duration = footer.duration;
+    return true;
+}
+
+bool ReplayReader::buildIndex()
+{
+    // Everything up to the first record that can't be decoded, evicting what was scanned as it goes
+    m_End = m_Size;
+    uint64_t offset = sizeof(ReplayFileHeader);
+    uint64_t evicted = 0;
+    uint64_t time = 0;
+    ReplayEvent event;
+    for(uint64_t start = offset; read(offset, time, event, nullptr); start = offset) {
+        if(event.type == ReplayEventType::Keyframe) { m_ScannedIndex.push_back({ event.time, start }); }
+        time = event.time;
+        if(offset - evicted > REPLAY_PREFETCH_BYTES) {
+            evict(evicted, offset - evicted);
+            evicted = offset;
+        }
+    }
+    m_End = offset;
+    m_Duration = time;
+    m_Index = (const uint8_t*)m_ScannedIndex.data();
+    m_KeyframeCount = m_ScannedIndex.size();
+    return m_KeyframeCount > 0;
+}
+
+ReplayKeyframe ReplayReader::getKeyframe(uint64_t index) const
+{
+    // The index of a file isn't necessarily aligned
+    ReplayKeyframe keyframe;
+    std::memcpy(&keyframe, m_Index + index * sizeof(ReplayKeyframe), sizeof(keyframe));
+    return keyframe;
+}
+
+ReplayKeyframe ReplayReader::findKeyframe(uint64_t time) const
+{
+    uint64_t low = 0, high = m_KeyframeCount;
+    while(high - low > 1) {
+        uint64_t middle = (low + high) / 2;
+        if(getKeyframe(middle).time <= time) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return getKeyframe(low);
+}
+
+bool ReplayReader::read(uint64_t& offset, uint64_t previousTime, ReplayEvent& event, RubiksCube* cube) const
+{
+    const uint8_t* data = m_Data;
+    uint64_t position = offset;
+    uint64_t delta, value;
+    if(!readVarint(data, m_End, position, delta) || position >= m_End) { return false; }
+
+    uint8_t type = data[position++];
+    if(type >= (uint8_t)ReplayEventType::Count) { return false; }
+    event.type = (ReplayEventType)type;
+    event.time = previousTime + delta;
+
+    for(int i = 0; i < ARG_COUNTS[type]; i++) {
+        if(!readVarint(data, m_End, position, value)) { return false; }
+        event.args[i] = (int)value;
+    }
+    for(int i = 0; i < VALUE_COUNTS[type]; i++) {
+        if(!readFloat(data, m_End, position, event.values[i])) { return false; }
+    }
+
+    if(event.type == ReplayEventType::Keyframe) {
+        // Absolute time, rotation angle, then id, position and rotation of every cubie
+        if(!readVarint(data, m_End, position, event.time)) { return false; }
+        uint64_t snapshot = position;
+        position += 4;
+        for(int i = 0; i < CUBIE_COUNT; i++) {
+            if(!readVarint(data, m_End, position, value)) { return false; }
+            position += 12 * 4;
+        }
+        if(position > m_End) { return false; }
+
+        if(cube) {
+            Cubie cubes[CUBIE_COUNT];
+            float rotationAngle;
+            readFloat(data, m_End, snapshot, rotationAngle);
+            for(Cubie& cubie : cubes) {
+                readVarint(data, m_End, snapshot, value);
+                cubie.id = (int)value;
+                for(int k = 0; k < 3; k++) {
+                    readFloat(data, m_End, snapshot, cubie.position[k]);
+                }
+                cubie.rotationMatrix = glm::mat4(1.0f);
+                for(int column = 0; column < 3; column++) {
+                    for(int row = 0; row < 3; row++) {
+                        readFloat(data, m_End, snapshot, cubie.rotationMatrix[column][row]);
+                    }
+                }
+            }
+            cube->restore(cubes, rotationAngle);
+        }
+    }
+
+    offset = position;
+    return true;
+}
+
+////////////
+// Player //
+////////////
+
+void ReplayPlayer::seek(double seconds, RubiksCube& cube)
+{
+    if(!m_Reader.getKeyframeCount()) { return; }
+
+    uint64_t time = (uint64_t)std::llround(std::max(seconds, 0.0) * 1e6);
+    ReplayKeyframe keyframe = m_Reader.findKeyframe(time);
+
+    // Seeking forward within the interval being played, e.g. while a seek key is held, only decodes what is new
+    if(m_Offset != 0 && time >= m_Position && m_Reader.findKeyframe(m_Position).offset == keyframe.offset) {
+        advanceTo(time, cube);
+        return;
+    }
+
+    // Move the cursor and its window to the keyframe, stream() prefetches from the cursor. A keyframe already in
+    // the window keeps it, advanceTo() streams on from there.
+    if(keyframe.offset >= m_WindowStart && keyframe.offset < m_PrefetchEnd) {
+        m_Offset = keyframe.offset;
+    } else {
+        m_Reader.evict(m_WindowStart, m_PrefetchEnd - m_WindowStart);
+        m_Offset = keyframe.offset;
+        m_WindowStart = keyframe.offset;
+        m_PrefetchEnd = keyframe.offset;
+        stream();
+    }
+
+    m_HasPending = false;
+    if(!m_Reader.read(m_Offset, 0, m_Pending, &cube)) { return; }
+
+    m_Time = keyframe.time;
+    m_Position = keyframe.time;
+    advanceTo(time, cube);
+}
+
+void ReplayPlayer::advance(double seconds, RubiksCube& cube)
+{
+    if(!m_Reader.getKeyframeCount()) { return; }
+    if(m_Offset == 0) { seek(0.0, cube); }
+    advanceTo(m_Position + (uint64_t)std::llround(std::max(seconds, 0.0) * 1e6), cube);
+}
+
+void ReplayPlayer::advanceTo(uint64_t time, RubiksCube& cube)
+{
+    time = std::min(time, m_Reader.getDuration());
+    for(;;) {
+        if(!m_HasPending) {
+            // Keyframes in the way hold the state the events already produced
+            if(!m_Reader.read(m_Offset, m_Time, m_Pending, nullptr)) { break; }
+            m_Time = m_Pending.time;
+            m_HasPending = true;
+            if(m_Offset + REPLAY_PREFETCH_BYTES / 2 > m_PrefetchEnd) { stream(); }
+        }
+        if(m_Pending.time > time) { break; }
+
+        ApplyReplayEvent(m_Pending, cube);
+        m_HasPending = false;
+    }
+    m_Position = std::max(m_Position, time);
+}
+
+void ReplayPlayer::stream()
+{
+    // Prefetch the next window while the current one is decoded, evict what is a window behind
+    uint64_t cursor = std::max(m_Offset, m_WindowStart);
+    m_Reader.prefetch(m_PrefetchEnd, cursor + REPLAY_PREFETCH_BYTES - m_PrefetchEnd);
+    m_PrefetchEnd = cursor + REPLAY_PREFETCH_BYTES;
+    if(cursor > m_WindowStart + REPLAY_PREFETCH_BYTES) {
+        m_Reader.evict(m_WindowStart, cursor - REPLAY_PREFETCH_BYTES - m_WindowStart);
+        m_WindowStart = cursor - REPLAY_PREFETCH_BYTES;
+    }
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "RubiksCube.h"
+#include <MappedFile.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static constexpr char REPLAY_FILE_MAGIC[8] = { 'C', 'U', 'B', 'E', 'R', 'E', 'P', '\0' };
+static constexpr char REPLAY_INDEX_MAGIC[8] = { 'C', 'U', 'B', 'E', 'I', 'D', 'X', '\0' };
+static constexpr uint32_t REPLAY_FILE_VERSION = 1;
+
+// Events between two keyframes, the most a seek has to replay
+static constexpr int REPLAY_KEYFRAME_INTERVAL = 256;
+
+// Bytes of a mapped replay prefetched ahead of the playback cursor, pages further behind it are evicted
+static constexpr uint64_t REPLAY_PREFETCH_BYTES = 4 << 20;
+
+/*
+A replay file is the header, then records, then the keyframe index and the footer.
+Every record is a varint of the microseconds since the previous record, the event type and its payload:
+varints for integers, raw little endian floats. Keyframes hold their absolute time and a snapshot of every cubie,
+so decoding can start at any of them. A file whose recording was interrupted has no index, it is rebuilt by
+scanning the records.
+*/
+struct ReplayFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t keyframeInterval;
+    uint64_t reserved[2];
+};
+
+struct ReplayKeyframe
+{
+    uint64_t time;      // microseconds since the start of the recording
+    uint64_t offset;    // of the keyframe record in the file
+};
+
+// Last bytes of the file, after the array of ReplayKeyframe
+struct ReplayFileFooter
+{
+    uint64_t indexOffset;
+    uint64_t keyframeCount;
+    uint64_t duration;
+    char magic[8];
+};
+
+enum class ReplayEventType : uint8_t
+{
+    Reset,                      // RubiksCube::reset
+    RotateFace,                 // args[0]: face, turned by the current rotation angle
+    RotateCube,                 // args[0]: axis, 0-2 for +x, +y, +z and 3-5 for -x, -y, -z
+    ApplyMove,                  // args[0]: CubeState move
+    RotateLayers,               // args: axis, layers, quarters
+    SetRotationAngle,           // values[0]: degrees
+    ChangeRotationDirection,
+    RotateCubie,                // args[0]: slot in the cubes array, values: rotation quaternion (w, x, y, z)
+    TranslateCubie,             // args[0]: slot in the cubes array, values: translation
+    Keyframe,                   // snapshot of the whole cube, only in files
+    Count
+};
+
+struct ReplayEvent
+{
+    ReplayEventType type;
+    uint64_t time = 0;          // microseconds since the start of the recording
+    int args[3] = {};
+    float values[4] = {};
+};
+
+void ApplyReplayEvent(const ReplayEvent& event, RubiksCube& cube);
+
+// Encodes a recording, to a file or in memory
+class ReplayWriter
+{
+    private:
+        std::FILE* m_File = nullptr;
+        bool m_Open = false;
+        std::vector<uint8_t> m_Buffer;
+        uint64_t m_Flushed = 0;     // bytes of the file already written
+        uint64_t m_LastTime = 0;
+        int m_SinceKeyframe = 0;
+        std::vector<ReplayKeyframe> m_Keyframes;
+
+        void writeKeyframe(uint64_t time, const RubiksCube& cube);
+        void flush();
+
+    public:
+        ~ReplayWriter() { finish(m_LastTime); }
+
+        // Start a file, or a recording kept in memory with an empty path, with a keyframe of the cube
+        bool open(const std::string& path, const RubiksCube& cube);
+        bool isOpen() const { return m_Open; }
+
+        // Append an event already applied to the cube, every REPLAY_KEYFRAME_INTERVAL events a keyframe follows
+        void write(const ReplayEvent& event, const RubiksCube& cube);
+
+        // Write the index and the footer and close the file
+        void finish(uint64_t duration);
+
+        // The encoded recording when kept in memory
+        const std::vector<uint8_t>& getBytes() const { return m_Buffer; }
+};
+
+// Records what the user does to the cube through the key and mouse callbacks
+class ReplayRecorder
+{
+    private:
+        ReplayWriter m_Writer;
+        std::chrono::steady_clock::time_point m_Start;
+
+        ReplayRecorder() {};
+
+        uint64_t now() const;
+
+    public:
+        static ReplayRecorder &getInstance() {
+            static ReplayRecorder instance;
+            return instance;
+        }
+
+        bool start(const std::string& path);
+        void stop();
+        bool isRecording() const { return m_Writer.isOpen(); }
+
+        // Call after applying the event to the cube, does nothing when not recording
+        void record(ReplayEventType type, int arg = 0);
+        void record(ReplayEventType type, int arg, const float* values, int valueCount);
+};
+
+/*
+Random access to the events of a replay. Files are memory mapped and decoded lazily, the keyframe index is read
+in place, so memory only holds the pages around the records being read.
+*/
+class ReplayReader
+{
+    private:
+        MappedFile m_File;
+        std::vector<uint8_t> m_Bytes;   // recordings loaded from memory
+        const uint8_t* m_Data = nullptr;
+        uint64_t m_Size = 0;
+        uint64_t m_End = 0;             // end of the records
+        uint64_t m_Duration = 0;
+
+        // The index of the file, or the one rebuilt by scanning an interrupted recording
+        const uint8_t* m_Index = nullptr;
+        uint64_t m_KeyframeCount = 0;
+        std::vector<ReplayKeyframe> m_ScannedIndex;
+
+        bool parse();
+        bool buildIndex();
+
+    public:
+        // Map a file, false with a message when it isn't a replay
+        bool open(const std::string& path);
+        bool load(const std::vector<uint8_t>& bytes);
+
+        uint64_t getDuration() const { return m_Duration; }
+        uint64_t getKeyframeCount() const { return m_KeyframeCount; }
+        ReplayKeyframe getKeyframe(uint64_t index) const;
+
+        // Last keyframe at or before `time`, binary searched in the index
+        ReplayKeyframe findKeyframe(uint64_t time) const;
+
+        // Decode the record at `offset` and move past it, `previousTime` is the time of the record before. Keyframes
+        // are restored into `cube` when it is given. False at the end of the records or when they are corrupted.
+        bool read(uint64_t& offset, uint64_t previousTime, ReplayEvent& event, RubiksCube* cube) const;
+
+        // Paging of mapped files, see MappedFile
+        void prefetch(uint64_t offset, uint64_t length) const { m_File.prefetch(offset, length); }
+        void evict(uint64_t offset, uint64_t length) const { m_File.evict(offset, length); }
+};
+
+// Plays a replay on the cube, seeking restores the closest keyframe and replays the events after it. Memory stays
+// flat whatever the size of the file and the playback speed.
+class ReplayPlayer
+{
+    private:
+        ReplayReader m_Reader;
+        uint64_t m_Offset = 0;      // next record
+        uint64_t m_Time = 0;        // time of the last decoded record
+        uint64_t m_Position = 0;    // playback position
+        ReplayEvent m_Pending;      // decoded but not yet due
+        bool m_HasPending = false;
+
+        // Records around the cursor, kept in memory: prefetched up to m_PrefetchEnd, evicted before m_WindowStart
+        uint64_t m_WindowStart = 0;
+        uint64_t m_PrefetchEnd = 0;
+
+        void advanceTo(uint64_t time, RubiksCube& cube);
+        void stream();
+
+    public:
+        bool open(const std::string& path) { return m_Reader.open(path); }
+        bool load(const std::vector<uint8_t>& bytes) { return m_Reader.load(bytes); }
+
+        void seek(double seconds, RubiksCube& cube);
+        // Apply the events due in the next `seconds`, from the start of the replay when it wasn't seeked
+        void advance(double seconds, RubiksCube& cube);
+
+        double getPosition() const { return m_Position * 1e-6; }
+        double getDuration() const { return m_Reader.getDuration() * 1e-6; }
+        bool isDone() const { return m_Position >= m_Reader.getDuration(); }
+};
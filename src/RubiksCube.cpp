@@ -1,6 +1,7 @@
 #include "RubiksCube.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <cstdio>
 
 #define sign(x) ((x) < 0 ? -1 : 1)
@@ -11,6 +12,11 @@ const glm::vec3 Y_AXIS = CUBE_Y_AXIS;
 const glm::vec3 Z_AXIS = CUBE_Z_AXIS;
 
 RubiksCube::RubiksCube(): rotationAngle(glm::radians(-90.0f)), cubes{}
+{
+    reset();
+}
+
+void RubiksCube::reset()
 {
     for(int x = -1; x <= 1; x++) {
         for(int y = -1; y <= 1; y++) {
@@ -18,9 +24,11 @@ RubiksCube::RubiksCube(): rotationAngle(glm::radians(-90.0f)), cubes{}
                 int index = (x + 1) * 9 + (y + 1) * 3 + (z + 1);
                 cubes[index].position = OFFSET * glm::vec3(x, y, z);
                 cubes[index].rotationMatrix = glm::rotate(glm::mat4(1.0f), 0.0f, glm::vec3(1.0f));
+                cubes[index].id = index;
             }
         }
     }
+    changeCount++;
 }
 
 glm::vec3 getOriginOfRotation(int minX, int minY, int minZ, int maxX, int maxY, int maxZ)
@@ -48,28 +56,34 @@ void RubiksCube::rotate(int minX, int minY, int minZ, int maxX, int maxY, int ma
     glm::mat4 toOriginIndex = glm::translate(glm::mat4(1.0f), originOfRotationIndex);
     glm::mat4 indexTranformation = toOriginIndex * rotation * fromOriginIndex;
 
-    // saving new states of the cubes
-    std::array<Cubie, 27> newCubes = cubes;
+    // the turned cubies only trade slots within the slice, only they are gathered before being written back
+    Cubie turned[27];
+    int newIndices[27];
+    int count = 0;
 
     for(int x = minX; x <= maxX; x++) {
         for(int y = minY; y <= maxY; y++) {
             for(int z = minZ; z <= maxZ; z++) {
                 int index = (x + 1) * 9 + (y + 1) * 3 + (z + 1);
                 // compute new orientation and position
-                cubes[index].rotationMatrix = rotation * cubes[index].rotationMatrix;
-                cubes[index].position = glm::vec3(transformation * glm::vec4(cubes[index].position, 1.0f));
+                Cubie cubie = cubes[index];
+                cubie.rotationMatrix = rotation * cubie.rotationMatrix;
+                cubie.position = glm::vec3(transformation * glm::vec4(cubie.position, 1.0f));
                 // compute new index after rotation
                 glm::vec3 newIndexVector = glm::vec3(indexTranformation * glm::vec4(x , y , z , 1.0f));
                 int newX = glm::round(newIndexVector.x);
                 int newY = glm::round(newIndexVector.y);
                 int newZ = glm::round(newIndexVector.z);
-                int newIndex = (newX + 1) * 9 + (newY + 1) * 3 + (newZ + 1);
-                newCubes[newIndex] = cubes[index];
+                turned[count] = cubie;
+                newIndices[count++] = (newX + 1) * 9 + (newY + 1) * 3 + (newZ + 1);
             }
         }
     }
 
-    cubes = newCubes;
+    for(int i = 0; i < count; i++) {
+        cubes[newIndices[i]] = turned[i];
+    }
+    changeCount++;
 }
 
 void RubiksCube::rotateFace(int faceIndex)
@@ -106,6 +120,57 @@ void RubiksCube::rotateFace(int faceIndex)
 
 void RubiksCube::rotateCube(glm::vec3 axis) { rotate(-1, -1, -1, 1, 1, 1, axis); }
 
+void RubiksCube::applyMove(int move)
+{
+    // Outward normals of the faces in FaceIndex order
+    static const glm::vec3 FACE_AXES[6] = { Z_AXIS, -Z_AXIS, -X_AXIS, X_AXIS, Y_AXIS, -Y_AXIS };
+
+    glm::mat3 core = glm::mat3(1.0f);
+    for(const Cubie& cubie : cubes) {
+        if(cubie.id == 13) { core = glm::mat3(cubie.rotationMatrix); }
+    }
+
+    // The world face the core's face points to now
+    glm::vec3 axis = core * FACE_AXES[move / 3];
+    int face = 0;
+    for(int f = 1; f < 6; f++) {
+        if(glm::dot(axis, FACE_AXES[f]) > glm::dot(axis, FACE_AXES[face])) { face = f; }
+    }
+
+    float angle = rotationAngle;
+    rotationAngle = glm::radians(-90.0f);
+    for(int quarter = 0; quarter <= move % 3; quarter++) {
+        rotateFace(face);
+    }
+    rotationAngle = angle;
+}
+
+void RubiksCube::rotateLayers(int axis, int layers, int quarters)
+{
+    static const glm::vec3 AXES[3] = { X_AXIS, Y_AXIS, Z_AXIS };
+
+    float angle = rotationAngle;
+    rotationAngle = glm::radians(-90.0f);
+    for(int layer = 0; layer < 3; layer++) {
+        if(!(layers & (1 << layer))) { continue; }
+
+        int min[3] = { -1, -1, -1 };
+        int max[3] = { 1, 1, 1 };
+        min[axis] = max[axis] = layer - 1;
+        for(int quarter = 0; quarter < quarters; quarter++) {
+            rotate(min[0], min[1], min[2], max[0], max[1], max[2], AXES[axis]);
+        }
+    }
+    rotationAngle = angle;
+}
+
+void RubiksCube::restore(const Cubie* savedCubes, float savedRotationAngle)
+{
+    std::copy(savedCubes, savedCubes + cubes.size(), cubes.begin());
+    rotationAngle = savedRotationAngle;
+    changeCount++;
+}
+
 void RubiksCube::setRotationAngle(float degrees)
 {
     if(degrees > 180) {
@@ -115,4 +180,29 @@ void RubiksCube::setRotationAngle(float degrees)
     }
 
     rotationAngle = sign(rotationAngle) * glm::radians(degrees);
+}
+
+unsigned long long RubiksCube::getStateHash() const
+{
+    // FNV-1a over the quantized state of every cubie
+    unsigned long long hash = 14695981039346656037ull;
+    auto mix = [&hash](int value) {
+        for(int byte = 0; byte < 4; byte++) {
+            hash ^= (unsigned long long)((value >> (8 * byte)) & 0xFF);
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for(const Cubie& cubie : cubes) {
+        mix(cubie.id);
+        for(int k = 0; k < 3; k++) {
+            mix((int)glm::round(cubie.position[k] / OFFSET * 16.0f));
+        }
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 3; row++) {
+                mix((int)glm::round(cubie.rotationMatrix[column][row] * 16.0f));
+            }
+        }
+    }
+    return hash;
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ static constexpr glm::vec3 CUBE_Z_AXIS = glm::vec3(0.0f, 0.0f, 1.0f);
 struct Cubie {
     glm::vec3 position;
     glm::mat4 rotationMatrix;
+    int id; // index of the cubie in the solved cube, travels with the cubie
 };
 
 class RubiksCube {
@@ -20,6 +21,9 @@ class RubiksCube {
 
         std::array<Cubie, 27> cubes;
 
+        // Incremented on every change of the cubies, so that unchanged frames can be skipped
+        unsigned long long changeCount = 0;
+
         RubiksCube();
 
         void rotate(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, glm::vec3 axis);
@@ -42,9 +46,32 @@ class RubiksCube {
 
         void rotateCube(glm::vec3 axis);
 
+        // Clockwise turn of 1-3 quarters numbered as in CubeState (face * 3 + quarters - 1), whatever the
+        // rotation angle is. Faces are relative to the core, so solutions still apply after whole cube rotations.
+        void applyMove(int move);
+
+        // Clockwise quarter turns seen from the positive side of axis 0 (x), 1 (y) or 2 (z), whatever the rotation
+        // angle. Bit i of `layers` selects the layer at coordinate i - 1, see LayerTurn.
+        void rotateLayers(int axis, int layers, int quarters);
+
         void changeRotationDirection() { rotationAngle *= -1.0f; }
 
         void setRotationAngle(float degrees);
 
+        // Put every cubie back to its solved position and orientation
+        void reset();
+
+        // Hash of the cubie arrangement, positions and rotations are quantized so float noise doesn't matter
+        unsigned long long getStateHash() const;
+
+        // Call after changing cubies through getCubes()
+        void markChanged() { changeCount++; }
+        unsigned long long getChangeCount() const { return changeCount; }
+
         Cubie* getCubes() { return cubes.data(); }
+        const Cubie* getCubes() const { return cubes.data(); }
+
+        // Signed rotation angle in radians and restoring a saved state, for replays
+        float getRawRotationAngle() const { return rotationAngle; }
+        void restore(const Cubie* savedCubes, float savedRotationAngle);
 };
\ No newline at end of file
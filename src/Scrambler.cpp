@@ -0,0 +1,60 @@
+#include <Scrambler.h>
+
+#include <algorithm>
+
+// Fisher-Yates shuffle of the identity
+template<int N>
+static void shuffle(uint8_t (&permutation)[N], Xoshiro256& random)
+{
+    for(int i = 0; i < N; i++) {
+        permutation[i] = i;
+    }
+    for(int i = N - 1; i > 0; i--) {
+        std::swap(permutation[i], permutation[random.below(i + 1)]);
+    }
+}
+
+template<int N>
+static int parity(const uint8_t (&permutation)[N])
+{
+    int inversions = 0;
+    for(int i = 0; i < N; i++) {
+        for(int j = i + 1; j < N; j++) {
+            inversions += permutation[i] > permutation[j];
+        }
+    }
+    return inversions & 1;
+}
+
+CubeState RandomState(Xoshiro256& random)
+{
+    CubeState state;
+    shuffle(state.cp, random);
+    shuffle(state.ep, random);
+    // Swapping two edges maps odd edge permutations one to one onto even ones, so the result stays uniform
+    if(parity(state.cp) != parity(state.ep)) { std::swap(state.ep[EDGE_COUNT - 2], state.ep[EDGE_COUNT - 1]); }
+
+    int twist = 0, flip = 0;
+    for(int i = 0; i < CORNER_COUNT - 1; i++) {
+        state.co[i] = random.below(3);
+        twist += state.co[i];
+    }
+    state.co[CORNER_COUNT - 1] = (3 - twist % 3) % 3;
+    for(int i = 0; i < EDGE_COUNT - 1; i++) {
+        state.eo[i] = random.below(2);
+        flip += state.eo[i];
+    }
+    state.eo[EDGE_COUNT - 1] = flip % 2;
+    return state;
+}
+
+void Scrambler::next(std::vector<int>& moves)
+{
+    // Every solvable state has a two-phase solution within TWO_PHASE_MAX_LENGTH moves
+    std::vector<int> solution;
+    CubeState state = RandomState(m_Random);
+    if(!m_Solver.solve(state, solution, m_MaxLength)) {
+        m_Solver.solve(state, solution);
+    }
+    moves = InvertMoves(solution);
+}
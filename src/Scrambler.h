@@ -0,0 +1,30 @@
+#pragma once
+
+#include <CubeState.h>
+#include <Random.h>
+#include <TwoPhaseSolver.h>
+
+#include <vector>
+
+// Solutions are searched until one is at most this long. Scrambles average ~22 moves, like the WCA's,
+// lower limits make them shorter but much slower to find.
+static constexpr int SCRAMBLE_MAX_LENGTH = 23;
+
+// Uniformly distributed among the 43 quintillion solvable states
+CubeState RandomState(Xoshiro256& random);
+
+// Random-state scrambles: a random solvable state is solved, the inverse of the solution reaches it from solved
+class Scrambler
+{
+    private:
+        Xoshiro256 m_Random;
+        TwoPhaseSolver m_Solver;
+        int m_MaxLength;
+
+    public:
+        Scrambler(uint64_t seed, int maxLength = SCRAMBLE_MAX_LENGTH)
+            : m_Random(seed), m_MaxLength(maxLength) {};
+
+        // Moves from solved to the next random state, in CubeState numbering
+        void next(std::vector<int>& moves);
+};
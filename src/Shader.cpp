@@ -1,4 +1,5 @@
 #include <Shader.h>
+#include <RenderState.h>
 
 Shader::Shader(const std::string& filepath)
     : m_Filepath(filepath), m_RendererID(0)
@@ -9,6 +10,7 @@ Shader::Shader(const std::string& filepath)
 
 Shader::~Shader()
 {
+    RenderState::getInstance().forget(RenderBinding::Program, m_RendererID);
     GLCall(glDeleteProgram(m_RendererID));
 }
 
@@ -37,6 +39,21 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
                 type = ShaderType::FRAGMENT;
             }
         }
+        else if (line.rfind("#include", 0) == 0)
+        {
+            // #include "file": shared code pasted in, the path is relative to the shader
+            size_t first = line.find('"'), last = line.rfind('"');
+            std::string directory = filepath.substr(0, filepath.find_last_of('/') + 1);
+            std::ifstream include(directory + line.substr(first + 1, last - first - 1));
+            if (first == std::string::npos || last <= first || !include)
+            {
+                std::cout << "Warning: can't include " << line << " in " << filepath << std::endl;
+            }
+            else
+            {
+                ss[(int)type] << include.rdbuf() << '\n';
+            }
+        }
         else 
         {
             ss[(int)type] << line << '\n';
@@ -89,47 +106,69 @@ unsigned int Shader::CreateShader(const std::string& vertexShader, const std::st
 
 void Shader::Bind() const
 {
-    GLCall(glUseProgram(m_RendererID));
+    RenderState::getInstance().useProgram(m_RendererID);
 }
 
 void Shader::Unbind() const
 {
-    GLCall(glUseProgram(0));
+    RenderState::getInstance().useProgram(0);
 }
 
-void Shader::SetUniform1i(const std::string& name, int value)
+void Shader::SetUniform1i(std::string_view name, int value)
 {
     GLCall(glUniform1i(GetUniformLocation(name), value));
 }
 
-void Shader::SetUniform1f(const std::string& name, float value)
+void Shader::SetUniform1f(std::string_view name, float value)
 {
     GLCall(glUniform1f(GetUniformLocation(name), value));
 }
 
-void Shader::SetUniform4f(const std::string& name, glm::vec4& value)
+void Shader::SetUniform2f(std::string_view name, const glm::vec2& value)
+{
+    GLCall(glUniform2f(GetUniformLocation(name), value.x, value.y));
+}
+
+void Shader::SetUniform3f(std::string_view name, const glm::vec3& value)
+{
+    GLCall(glUniform3f(GetUniformLocation(name), value.x, value.y, value.z));
+}
+
+void Shader::SetUniform3i(std::string_view name, const glm::ivec3& value)
+{
+    GLCall(glUniform3i(GetUniformLocation(name), value.x, value.y, value.z));
+}
+
+void Shader::SetUniform4f(std::string_view name, const glm::vec4& value)
 {
     GLCall(glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w));
 }
 
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+void Shader::SetUniformMat4f(std::string_view name, const glm::mat4& matrix)
 {
     GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
 }
 
-int Shader::GetUniformLocation(const std::string& name)
+int Shader::GetUniformLocation(std::string_view name)
 {
-    if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
+    size_t hash = std::hash<std::string_view>()(name);
+    auto cached = m_UniformLocationCache.find(hash);
+    if (cached != m_UniformLocationCache.end() && cached->second.name == name)
     {
-        return m_UniformLocationCache[name];
+        return cached->second.location;
     }
 
-    GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
+    std::string key(name);
+    GLCall(int location = glGetUniformLocation(m_RendererID, key.c_str()));
     if (location == -1)
     {
-        std::cout << "Warning: uniform '" << name << "' doesn't exist!" << std::endl;
+        std::cout << "Warning: uniform '" << key << "' doesn't exist!" << std::endl;
+    }
+
+    // Two names with the same hash: the first one keeps the entry, the other is looked up every time
+    if (cached == m_UniformLocationCache.end())
+    {
+        m_UniformLocationCache.emplace(hash, UniformLocation{ key, location });
     }
-    
-    m_UniformLocationCache[name] = location;
     return location;
-}
\ No newline at end of file
+}
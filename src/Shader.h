@@ -9,6 +9,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 struct ShaderProgramSource
@@ -22,7 +23,13 @@ class Shader
     private:
         std::string m_Filepath;
         unsigned int m_RendererID;
-        std::unordered_map<std::string, int> m_UniformLocationCache;
+        // Keyed by the hash of the name, so setting a uniform by a string literal doesn't build a std::string
+        struct UniformLocation
+        {
+            std::string name;
+            int location;
+        };
+        std::unordered_map<size_t, UniformLocation> m_UniformLocationCache;
     public:
         Shader(const std::string& filepath);
         ~Shader();
@@ -31,14 +38,17 @@ class Shader
         void Unbind() const;
 
         // Set uniforms
-        void SetUniform1i(const std::string& name, int value);
-        void SetUniform1f(const std::string& name, float value);
-        void SetUniform4f(const std::string& name, glm::vec4& value);
-        void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
+        void SetUniform1i(std::string_view name, int value);
+        void SetUniform1f(std::string_view name, float value);
+        void SetUniform2f(std::string_view name, const glm::vec2& value);
+        void SetUniform3f(std::string_view name, const glm::vec3& value);
+        void SetUniform3i(std::string_view name, const glm::ivec3& value);
+        void SetUniform4f(std::string_view name, const glm::vec4& value);
+        void SetUniformMat4f(std::string_view name, const glm::mat4& matrix);
     private:
         ShaderProgramSource ParseShader(const std::string& filepath);
         unsigned int CompileShader(unsigned int type, const std::string& source);
         unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
 
-        int GetUniformLocation(const std::string& name);
+        int GetUniformLocation(std::string_view name);
 };
\ No newline at end of file
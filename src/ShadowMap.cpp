@@ -0,0 +1,114 @@
+#include <ShadowMap.h>
+#include <RenderState.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Depth offset of the shadow casters, keeps lit faces from shadowing themselves
+const float SLOPE_BIAS = 2.0f;
+const float CONSTANT_BIAS = 4.0f;
+
+void ShadowRegion::add(const ShadowRegion& other)
+{
+    x0 = std::min(x0, other.x0);
+    y0 = std::min(y0, other.y0);
+    x1 = std::max(x1, other.x1);
+    y1 = std::max(y1, other.y1);
+}
+
+ShadowMap::ShadowMap()
+{
+    GLCall(glGenTextures(1, &m_Depth));
+    RenderState::getInstance().bindTexture(0, m_Depth);
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr));
+    // Hardware comparison with bilinear filtering gives 2x2 PCF for free
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL));
+    // Outside of the map nothing is in shadow
+    float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER));
+    GLCall(glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border));
+    RenderState::getInstance().bindTexture(0, 0);
+
+    GLCall(glGenFramebuffers(1, &m_FrameBuffer));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer));
+    GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_Depth, 0));
+    GLCall(glDrawBuffer(GL_NONE));
+    GLCall(glReadBuffer(GL_NONE));
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if(status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Warning: shadow map framebuffer is incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+ShadowMap::~ShadowMap()
+{
+    RenderState::getInstance().forget(RenderBinding::Texture, m_Depth);
+    GLCall(glDeleteTextures(1, &m_Depth));
+    GLCall(glDeleteFramebuffers(1, &m_FrameBuffer));
+}
+
+void ShadowMap::setScene(const glm::vec3& direction, const glm::vec3& center, float radius)
+{
+    glm::vec3 forward = glm::normalize(direction);
+    glm::vec3 up = glm::abs(forward.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 view = glm::lookAt(center - forward * 2.0f * radius, center, up);
+    glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, radius, 3.0f * radius);
+    m_LightViewProjection = projection * view;
+}
+
+ShadowRegion ShadowMap::getRegion(const glm::vec3& center, float radius) const
+{
+    // The projection is orthographic, a sphere covers the square around its projected center
+    glm::vec4 clip = m_LightViewProjection * glm::vec4(center, 1.0f);
+    const glm::mat4& m = m_LightViewProjection;
+    glm::vec2 extent = radius * glm::vec2(glm::length(glm::vec3(m[0][0], m[1][0], m[2][0])), glm::length(glm::vec3(m[0][1], m[1][1], m[2][1])));
+    float texels = 0.5f * SHADOW_MAP_SIZE;
+
+    ShadowRegion region;
+    region.x0 = std::max((int)std::floor((clip.x - extent.x + 1.0f) * texels) - SHADOW_REGION_MARGIN, 0);
+    region.y0 = std::max((int)std::floor((clip.y - extent.y + 1.0f) * texels) - SHADOW_REGION_MARGIN, 0);
+    region.x1 = std::min((int)std::ceil((clip.x + extent.x + 1.0f) * texels) + SHADOW_REGION_MARGIN, SHADOW_MAP_SIZE);
+    region.y1 = std::min((int)std::ceil((clip.y + extent.y + 1.0f) * texels) + SHADOW_REGION_MARGIN, SHADOW_MAP_SIZE);
+    return region;
+}
+
+void ShadowMap::begin(const ShadowRegion& region)
+{
+    GLCall(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_SavedFrameBuffer));
+    GLCall(glGetIntegerv(GL_VIEWPORT, m_SavedViewport));
+    GLCall(m_SavedScissorTest = glIsEnabled(GL_SCISSOR_TEST));
+    GLCall(glGetIntegerv(GL_SCISSOR_BOX, m_SavedScissor));
+
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer));
+    GLCall(glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE));
+    // The clear is scissored too, the rest of the map keeps the depth of the cubies that didn't move
+    GLCall(glEnable(GL_SCISSOR_TEST));
+    GLCall(glScissor(region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0));
+    GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+    GLCall(glEnable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glPolygonOffset(SLOPE_BIAS, CONSTANT_BIAS));
+}
+
+void ShadowMap::end()
+{
+    GLCall(glDisable(GL_POLYGON_OFFSET_FILL));
+    GLCall(glScissor(m_SavedScissor[0], m_SavedScissor[1], m_SavedScissor[2], m_SavedScissor[3]));
+    if(!m_SavedScissorTest) {
+        GLCall(glDisable(GL_SCISSOR_TEST));
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_SavedFrameBuffer));
+    GLCall(glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]));
+}
+
+void ShadowMap::bindTexture(unsigned int slot) const
+{
+    RenderState::getInstance().bindTexture(slot, m_Depth);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Debugger.h>
+
+#include <glm/glm.hpp>
+
+// Width and height of the shadow map in texels
+static constexpr int SHADOW_MAP_SIZE = 2048;
+
+// Texels added around a redrawn region, covers the PCF kernel of the lit shaders and the bilinear comparison
+static constexpr int SHADOW_REGION_MARGIN = 3;
+
+// Texel rectangle of the shadow map, x0 and y0 inclusive, x1 and y1 exclusive; empty when x0 >= x1 or y0 >= y1
+struct ShadowRegion
+{
+    int x0 = SHADOW_MAP_SIZE, y0 = SHADOW_MAP_SIZE;
+    int x1 = 0, y1 = 0;
+
+    bool isEmpty() const { return x0 >= x1 || y0 >= y1; }
+    long long getArea() const { return isEmpty() ? 0 : (long long)(x1 - x0) * (y1 - y0); }
+    void add(const ShadowRegion& other);
+    static ShadowRegion full() { ShadowRegion region; region.x0 = region.y0 = 0; region.x1 = region.y1 = SHADOW_MAP_SIZE; return region; }
+};
+
+/*
+Depth map of a directional light, seen through an orthographic projection fitted to a bounding sphere of the scene.
+It only depends on the cubies and the light, not on the camera, so it is rendered again only when they move, and
+then only in the region covered by the cubies that moved: begin() scissors the clear and the draw to it.
+*/
+class ShadowMap
+{
+    private:
+        unsigned int m_FrameBuffer = 0;
+        unsigned int m_Depth = 0;
+        glm::mat4 m_LightViewProjection = glm::mat4(1.0f);
+
+        // Bindings of the scene restored by end()
+        int m_SavedFrameBuffer = 0;
+        int m_SavedViewport[4] = {};
+        bool m_SavedScissorTest = false;
+        int m_SavedScissor[4] = {};
+
+    public:
+        ShadowMap();
+        ~ShadowMap();
+
+        // Fit the light projection to a sphere, `direction` is the direction the light travels
+        void setScene(const glm::vec3& direction, const glm::vec3& center, float radius);
+        const glm::mat4& getLightViewProjection() const { return m_LightViewProjection; }
+
+        // Texels covered by a sphere seen from the light, with the margin, clamped to the map
+        ShadowRegion getRegion(const glm::vec3& center, float radius) const;
+
+        // Render depth into the region of the map, then restore the framebuffer, viewport and scissor of the scene
+        void begin(const ShadowRegion& region = ShadowRegion::full());
+        void end();
+
+        // Depth texture with comparison enabled, for a sampler2DShadow
+        void bindTexture(unsigned int slot) const;
+};
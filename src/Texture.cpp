@@ -2,6 +2,7 @@
 #include <stb/stb_image_write.h>
 
 #include <Texture.h>
+#include <RenderState.h>
 
 Texture::Texture(const std::string& filepath)
     : m_RendererID(0), m_Filepath(filepath), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_Components(0)
@@ -16,7 +17,7 @@ Texture::Texture(const std::string& filepath)
     GLCall(glGenTextures(1, &m_RendererID));
 
     // Assigns the texture to a Texture Unit
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    RenderState::getInstance().bindTexture(0, m_RendererID);
 
     // Configures the type of algorithm that is used to make the image smaller or bigger
     GLCall(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR));
@@ -33,7 +34,7 @@ Texture::Texture(const std::string& filepath)
 	GLCall(glGenerateMipmap(GL_TEXTURE_2D));
 
     // Unbinds the OpenGL Texture object so that it can't accidentally be modified
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    RenderState::getInstance().bindTexture(0, 0);
 
     if (m_LocalBuffer)
     {
@@ -42,18 +43,42 @@ Texture::Texture(const std::string& filepath)
     }
 }
 
+Texture::Texture(int width, int height, const unsigned char* pixels)
+    : m_RendererID(0), m_Filepath(), m_LocalBuffer(nullptr), m_Width(width), m_Height(height), m_Components(4)
+{
+    GLCall(glGenTextures(1, &m_RendererID));
+    RenderState::getInstance().bindTexture(0, m_RendererID);
+
+    // Every texel is a single color, so no filtering or mipmaps are wanted
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+    // RGBA8 rows are a multiple of 4 bytes, the default unpack alignment of 4 fits any width
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+    RenderState::getInstance().bindTexture(0, 0);
+}
+
+void Texture::SetData(const unsigned char* pixels)
+{
+    RenderState::getInstance().bindTexture(0, m_RendererID);
+    GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+}
+
 Texture::~Texture()
 {
+    RenderState::getInstance().forget(RenderBinding::Texture, m_RendererID);
     GLCall(glDeleteTextures(1, &m_RendererID));
 }
 
 void Texture::Bind(unsigned int slot) const
 {
-    GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    RenderState::getInstance().bindTexture(slot, m_RendererID);
 }
 
-void Texture::Unbind() const
+void Texture::Unbind(unsigned int slot) const
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    RenderState::getInstance().bindTexture(slot, 0);
 }
\ No newline at end of file
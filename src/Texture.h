@@ -14,10 +14,15 @@ class Texture
         int m_Width, m_Height, m_Components;
     public:
         Texture(const std::string& filepath);
+        // Texture from raw RGBA pixels, sampled without filtering or mipmaps
+        Texture(int width, int height, const unsigned char* pixels);
         ~Texture();
 
+        // Replace the pixels of a texture created from raw RGBA pixels
+        void SetData(const unsigned char* pixels);
+
         void Bind(unsigned int slot = 0) const;
-        void Unbind() const;
+        void Unbind(unsigned int slot = 0) const;
 
         inline int GetWidth() const { return m_Width; }
         inline int GetHeight() const { return m_Height; }
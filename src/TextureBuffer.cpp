@@ -0,0 +1,38 @@
+#include <TextureBuffer.h>
+#include <RenderState.h>
+
+TextureBuffer::TextureBuffer(unsigned int format)
+    : m_Format(format)
+{
+    GLCall(glGenBuffers(1, &m_BufferID));
+    GLCall(glGenTextures(1, &m_RendererID));
+}
+
+TextureBuffer::~TextureBuffer()
+{
+    RenderState::getInstance().forget(RenderBinding::Texture, m_RendererID);
+    GLCall(glDeleteTextures(1, &m_RendererID));
+    GLCall(glDeleteBuffers(1, &m_BufferID));
+}
+
+void TextureBuffer::SetData(const void* data, unsigned int size)
+{
+    GLCall(glBindBuffer(GL_TEXTURE_BUFFER, m_BufferID));
+    if(size > m_Size) {
+        GLCall(glBufferData(GL_TEXTURE_BUFFER, size, data, GL_DYNAMIC_DRAW));
+        // The texture views the buffer object, it is attached once the buffer has storage
+        if(m_Size == 0) {
+            RenderState::getInstance().bindTexture(0, m_RendererID, GL_TEXTURE_BUFFER);
+            GLCall(glTexBuffer(GL_TEXTURE_BUFFER, m_Format, m_BufferID));
+        }
+        m_Size = size;
+    } else if(size > 0) {
+        GLCall(glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data));
+    }
+    GLCall(glBindBuffer(GL_TEXTURE_BUFFER, 0));
+}
+
+void TextureBuffer::Bind(unsigned int slot) const
+{
+    RenderState::getInstance().bindTexture(slot, m_RendererID, GL_TEXTURE_BUFFER);
+}
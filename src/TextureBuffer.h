@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Debugger.h>
+
+// TBO: a buffer read by shaders through a samplerBuffer, for arrays too large for uniforms
+class TextureBuffer
+{
+    private:
+        unsigned int m_BufferID;
+        unsigned int m_RendererID;
+        unsigned int m_Format;
+        unsigned int m_Size = 0;
+    public:
+        // `format` is the sized internal format of a texel, e.g. GL_RGBA32F or GL_R32UI
+        TextureBuffer(unsigned int format);
+        ~TextureBuffer();
+
+        // Replace the whole content, the storage grows as needed
+        void SetData(const void* data, unsigned int size);
+
+        void Bind(unsigned int slot) const;
+};
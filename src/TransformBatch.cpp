@@ -0,0 +1,277 @@
+#include <TransformBatch.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TRANSFORM_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Arrays are padded to a multiple of the widest kernel so that no kernel reads past the end
+const unsigned int BATCH_PADDING = 8;
+
+struct KernelArgs
+{
+    const float* position[3];
+    const float* rotation[9];
+    float scale;
+    const float* viewProjection; // column-major 4x4
+    glm::mat4* models;
+    glm::mat4* mvps;
+    unsigned int first;
+    unsigned int last;
+};
+
+//////////////////
+// Scalar kernel //
+//////////////////
+
+static void computeScalar(const KernelArgs& args)
+{
+    const float* vp = args.viewProjection;
+    for(unsigned int i = args.first; i < args.last; i++) {
+        float* mvp = &args.mvps[i][0][0];
+        for(int column = 0; column < 3; column++) {
+            float r0 = args.rotation[column * 3 + 0][i] * args.scale;
+            float r1 = args.rotation[column * 3 + 1][i] * args.scale;
+            float r2 = args.rotation[column * 3 + 2][i] * args.scale;
+            for(int row = 0; row < 4; row++) {
+                mvp[column * 4 + row] = vp[0 + row] * r0 + vp[4 + row] * r1 + vp[8 + row] * r2;
+            }
+        }
+        float p0 = args.position[0][i], p1 = args.position[1][i], p2 = args.position[2][i];
+        for(int row = 0; row < 4; row++) {
+            mvp[12 + row] = vp[12 + row] + vp[0 + row] * p0 + vp[4 + row] * p1 + vp[8 + row] * p2;
+        }
+
+        if(!args.models) { continue; }
+
+        float* model = &args.models[i][0][0];
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 3; row++) {
+                model[column * 4 + row] = args.rotation[column * 3 + row][i] * args.scale;
+            }
+            model[column * 4 + 3] = 0.0f;
+        }
+        model[12] = p0;
+        model[13] = p1;
+        model[14] = p2;
+        model[15] = 1.0f;
+    }
+}
+
+#ifdef TRANSFORM_BATCH_X86
+
+// Transpose 4 vectors holding one matrix element for 4 cubies into one matrix column per cubie
+static inline void storeColumns(__m128 row0, __m128 row1, __m128 row2, __m128 row3, glm::mat4* matrices, int column)
+{
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(&matrices[0][column][0], row0);
+    _mm_storeu_ps(&matrices[1][column][0], row1);
+    _mm_storeu_ps(&matrices[2][column][0], row2);
+    _mm_storeu_ps(&matrices[3][column][0], row3);
+}
+
+///////////////
+// SSE kernel //
+///////////////
+
+static unsigned int computeSSE(const KernelArgs& args)
+{
+    __m128 vp[16];
+    for(int e = 0; e < 16; e++) {
+        vp[e] = _mm_set1_ps(args.viewProjection[e]);
+    }
+    const __m128 scale = _mm_set1_ps(args.scale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    unsigned int i = args.first;
+    for(; i + 4 <= args.last; i += 4) {
+        __m128 p[3], r[9];
+        for(int k = 0; k < 3; k++) {
+            p[k] = _mm_loadu_ps(args.position[k] + i);
+        }
+        for(int k = 0; k < 9; k++) {
+            r[k] = _mm_mul_ps(_mm_loadu_ps(args.rotation[k] + i), scale);
+        }
+
+        __m128 rows[4];
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 4; row++) {
+                rows[row] = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(vp[0 + row], r[column * 3 + 0]),
+                    _mm_mul_ps(vp[4 + row], r[column * 3 + 1])),
+                    _mm_mul_ps(vp[8 + row], r[column * 3 + 2]));
+            }
+            storeColumns(rows[0], rows[1], rows[2], rows[3], args.mvps + i, column);
+        }
+        for(int row = 0; row < 4; row++) {
+            rows[row] = _mm_add_ps(_mm_add_ps(vp[12 + row], _mm_mul_ps(vp[0 + row], p[0])),
+                _mm_add_ps(_mm_mul_ps(vp[4 + row], p[1]), _mm_mul_ps(vp[8 + row], p[2])));
+        }
+        storeColumns(rows[0], rows[1], rows[2], rows[3], args.mvps + i, 3);
+
+        if(!args.models) { continue; }
+
+        for(int column = 0; column < 3; column++) {
+            storeColumns(r[column * 3 + 0], r[column * 3 + 1], r[column * 3 + 2], zero, args.models + i, column);
+        }
+        storeColumns(p[0], p[1], p[2], one, args.models + i, 3);
+    }
+    return i;
+}
+
+////////////////
+// AVX2 kernel //
+////////////////
+
+__attribute__((target("avx2,fma")))
+static inline void storeColumns8(__m256 row0, __m256 row1, __m256 row2, __m256 row3, glm::mat4* matrices, int column)
+{
+    storeColumns(_mm256_castps256_ps128(row0), _mm256_castps256_ps128(row1),
+        _mm256_castps256_ps128(row2), _mm256_castps256_ps128(row3), matrices, column);
+    storeColumns(_mm256_extractf128_ps(row0, 1), _mm256_extractf128_ps(row1, 1),
+        _mm256_extractf128_ps(row2, 1), _mm256_extractf128_ps(row3, 1), matrices + 4, column);
+}
+
+__attribute__((target("avx2,fma")))
+static unsigned int computeAVX2(const KernelArgs& args)
+{
+    __m256 vp[16];
+    for(int e = 0; e < 16; e++) {
+        vp[e] = _mm256_set1_ps(args.viewProjection[e]);
+    }
+    const __m256 scale = _mm256_set1_ps(args.scale);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    unsigned int i = args.first;
+    for(; i + 8 <= args.last; i += 8) {
+        __m256 p[3], r[9];
+        for(int k = 0; k < 3; k++) {
+            p[k] = _mm256_loadu_ps(args.position[k] + i);
+        }
+        for(int k = 0; k < 9; k++) {
+            r[k] = _mm256_mul_ps(_mm256_loadu_ps(args.rotation[k] + i), scale);
+        }
+
+        __m256 rows[4];
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 4; row++) {
+                rows[row] = _mm256_fmadd_ps(vp[8 + row], r[column * 3 + 2],
+                    _mm256_fmadd_ps(vp[4 + row], r[column * 3 + 1], _mm256_mul_ps(vp[0 + row], r[column * 3 + 0])));
+            }
+            storeColumns8(rows[0], rows[1], rows[2], rows[3], args.mvps + i, column);
+        }
+        for(int row = 0; row < 4; row++) {
+            rows[row] = _mm256_fmadd_ps(vp[8 + row], p[2],
+                _mm256_fmadd_ps(vp[4 + row], p[1], _mm256_fmadd_ps(vp[0 + row], p[0], vp[12 + row])));
+        }
+        storeColumns8(rows[0], rows[1], rows[2], rows[3], args.mvps + i, 3);
+
+        if(!args.models) { continue; }
+
+        for(int column = 0; column < 3; column++) {
+            storeColumns8(r[column * 3 + 0], r[column * 3 + 1], r[column * 3 + 2], zero, args.models + i, column);
+        }
+        storeColumns8(p[0], p[1], p[2], one, args.models + i, 3);
+    }
+    return i;
+}
+
+#endif
+
+void TransformBatch::resize(unsigned int count)
+{
+    m_Count = count;
+    unsigned int capacity = (count + BATCH_PADDING - 1) / BATCH_PADDING * BATCH_PADDING;
+    for(auto& component : m_Position) {
+        component.resize(capacity, 0.0f);
+    }
+    for(auto& component : m_Rotation) {
+        component.resize(capacity, 0.0f);
+    }
+}
+
+void TransformBatch::load(const Cubie* cubes, unsigned int count, unsigned int first)
+{
+    if(first + count > m_Count) {
+        resize(first + count);
+    }
+
+    for(unsigned int i = 0; i < count; i++) {
+        const Cubie& cubie = cubes[i];
+        for(int k = 0; k < 3; k++) {
+            m_Position[k][first + i] = cubie.position[k];
+        }
+        for(int column = 0; column < 3; column++) {
+            for(int row = 0; row < 3; row++) {
+                m_Rotation[column * 3 + row][first + i] = cubie.rotationMatrix[column][row];
+            }
+        }
+    }
+}
+
+void TransformBatch::compute(const glm::mat4& viewProjection, glm::mat4* models, glm::mat4* mvps) const
+{
+    compute(viewProjection, models, mvps, getBestKernel());
+}
+
+void TransformBatch::compute(const glm::mat4& viewProjection, glm::mat4* models, glm::mat4* mvps, TransformKernel kernel) const
+{
+    KernelArgs args;
+    for(int k = 0; k < 3; k++) {
+        args.position[k] = m_Position[k].data();
+    }
+    for(int k = 0; k < 9; k++) {
+        args.rotation[k] = m_Rotation[k].data();
+    }
+    args.scale = m_Scale;
+    args.viewProjection = &viewProjection[0][0];
+    args.models = models;
+    args.mvps = mvps;
+    args.first = 0;
+    args.last = m_Count;
+
+    // Never run a kernel the CPU can't execute
+    if(kernel > getBestKernel()) {
+        kernel = getBestKernel();
+    }
+
+#ifdef TRANSFORM_BATCH_X86
+    // The SIMD kernels stop at the last full register, the scalar kernel finishes the tail
+    if(kernel == TransformKernel::AVX2) {
+        args.first = computeAVX2(args);
+    } else if(kernel == TransformKernel::SSE) {
+        args.first = computeSSE(args);
+    }
+#endif
+    computeScalar(args);
+}
+
+TransformKernel TransformBatch::getBestKernel()
+{
+    static const TransformKernel best = []() {
+#ifdef TRANSFORM_BATCH_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return TransformKernel::AVX2;
+        }
+        return TransformKernel::SSE;
+#else
+        return TransformKernel::Scalar;
+#endif
+    }();
+    return best;
+}
+
+const char* TransformBatch::getKernelName(TransformKernel kernel)
+{
+    switch(kernel) {
+        case TransformKernel::SSE:
+            return "SSE";
+        case TransformKernel::AVX2:
+            return "AVX2";
+        default:
+            return "Scalar";
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "RubiksCube.h"
+
+#include <vector>
+
+/*
+TransformKernel:
+    Scalar: portable fallback,
+    SSE: 4 cubies per iteration,
+    AVX2: 8 cubies per iteration (with FMA)
+*/
+enum class TransformKernel
+{
+    Scalar = 0,
+    SSE = 1,
+    AVX2 = 2
+};
+
+// Structure of arrays copy of the cubie transforms, so that every lane of a SIMD register holds a different cubie
+class TransformBatch
+{
+    private:
+        unsigned int m_Count = 0;
+        float m_Scale = CUBIE_SCALE;
+
+        // Positions and the 3x3 rotation (column-major, m_Rotation[column * 3 + row]) of every cubie
+        std::vector<float> m_Position[3];
+        std::vector<float> m_Rotation[9];
+
+    public:
+        // Resize the batch, the capacity is padded so kernels may read whole registers
+        void resize(unsigned int count);
+
+        // Copy the transforms of `count` cubies starting at `first` in the batch
+        void load(const Cubie* cubes, unsigned int count, unsigned int first = 0);
+
+        void setScale(float scale) { m_Scale = scale; }
+
+        /*
+        Compute model = translate * rotate * scale and mvp = viewProjection * model for every cubie.
+        `models` may be nullptr when only the MVP matrices are needed.
+        */
+        void compute(const glm::mat4& viewProjection, glm::mat4* models, glm::mat4* mvps) const;
+        void compute(const glm::mat4& viewProjection, glm::mat4* models, glm::mat4* mvps, TransformKernel kernel) const;
+
+        unsigned int getCount() const { return m_Count; }
+
+        // Best kernel supported by the running CPU, detected once
+        static TransformKernel getBestKernel();
+        static const char* getKernelName(TransformKernel kernel);
+};
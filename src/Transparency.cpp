@@ -0,0 +1,108 @@
+#include <Transparency.h>
+
+#include <Renderer.h>
+#include <RenderState.h>
+
+#include <iostream>
+
+Transparency::Transparency()
+{
+    m_CompositeShader = std::make_unique<Shader>("res/shaders/oit_composite.shader");
+    m_FullscreenVa = VertexArray::GetShared(nullptr, EMPTY_VERTEX_FORMAT);
+
+    m_Width = m_Height = 1;
+    create();
+}
+
+Transparency::~Transparency()
+{
+    destroy();
+}
+
+void Transparency::create()
+{
+    GLCall(glGenFramebuffers(1, &m_FrameBuffer));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer));
+
+    // Sums of weights up to thousands, half floats keep enough precision
+    unsigned int* textures[2] = { &m_Accumulation, &m_Weights };
+    unsigned int formats[2] = { GL_RGBA16F, GL_R16F };
+    for(int i = 0; i < 2; i++) {
+        GLCall(glGenTextures(1, textures[i]));
+        RenderState::getInstance().bindTexture(0, *textures[i]);
+        GLCall(glTexImage2D(GL_TEXTURE_2D, 0, formats[i], m_Width, m_Height, 0, GL_RGBA, GL_FLOAT, nullptr));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, *textures[i], 0));
+    }
+    RenderState::getInstance().bindTexture(0, 0);
+
+    GLenum buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    GLCall(glDrawBuffers(2, buffers));
+
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    m_Supported = status == GL_FRAMEBUFFER_COMPLETE;
+    if(!m_Supported) {
+        std::cout << "Warning: transparency framebuffer is incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void Transparency::destroy()
+{
+    if(!m_FrameBuffer) { return; }
+
+    RenderState::getInstance().forget(RenderBinding::Texture, m_Accumulation);
+    RenderState::getInstance().forget(RenderBinding::Texture, m_Weights);
+    GLCall(glDeleteTextures(1, &m_Accumulation));
+    GLCall(glDeleteTextures(1, &m_Weights));
+    GLCall(glDeleteFramebuffers(1, &m_FrameBuffer));
+    m_FrameBuffer = 0;
+}
+
+void Transparency::begin(int width, int height)
+{
+    GLCall(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_SavedFrameBuffer));
+    GLCall(glGetIntegerv(GL_VIEWPORT, m_SavedViewport));
+
+    if(width != m_Width || height != m_Height) {
+        destroy();
+        m_Width = width;
+        m_Height = height;
+        create();
+    }
+
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+    float accumulation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    float weights[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    GLCall(glClearBufferfv(GL_COLOR, 0, accumulation));
+    GLCall(glClearBufferfv(GL_COLOR, 1, weights));
+
+    // Colors and weights add up, alpha multiplies by the transparency of every surface
+    GLCall(glDisable(GL_DEPTH_TEST));
+    GLCall(glDepthMask(GL_FALSE));
+    GLCall(glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA));
+}
+
+void Transparency::end()
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_SavedFrameBuffer));
+    GLCall(glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]));
+
+    RenderState::getInstance().bindTexture(0, m_Accumulation);
+    RenderState::getInstance().bindTexture(1, m_Weights);
+    m_CompositeShader->Bind();
+    m_CompositeShader->SetUniform1i("u_Accumulation", 0);
+    m_CompositeShader->SetUniform1i("u_Weights", 1);
+
+    // The scene shows through by the revealage
+    GLCall(glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA));
+    Renderer::DrawFullscreen(*m_FullscreenVa, *m_CompositeShader);
+
+    GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    GLCall(glDepthMask(GL_TRUE));
+    GLCall(glEnable(GL_DEPTH_TEST));
+}
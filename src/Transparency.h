@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Shader.h>
+#include <VertexArray.h>
+
+#include <memory>
+
+/*
+Weighted blended order-independent transparency (McGuire and Bavoil 2013). Transparent surfaces are drawn in any
+order into two float targets with additive blending: the sum of their premultiplied colors times a depth weight,
+with the product of their transparencies (revealage) in its alpha, and the sum of the weights. The composite
+blends their weighted average over the scene by the revealage, so no per-frame sorting is needed.
+
+The separate color and alpha blend functions give both values with a single blend state, as GL 3.3 has no blend
+function per draw buffer. Shaders drawn in between write both outputs, see oit.shader.
+*/
+class Transparency
+{
+    private:
+        unsigned int m_FrameBuffer = 0;
+        unsigned int m_Accumulation = 0;
+        unsigned int m_Weights = 0;
+        int m_Width = 0;
+        int m_Height = 0;
+        bool m_Supported = false;
+
+        // Framebuffer and viewport of the scene, composited into by end()
+        int m_SavedFrameBuffer = 0;
+        int m_SavedViewport[4] = {};
+
+        std::unique_ptr<Shader> m_CompositeShader;
+        std::shared_ptr<VertexArray> m_FullscreenVa;
+
+        void create();
+        void destroy();
+
+    public:
+        // Needs the OpenGL context to be current
+        Transparency();
+        ~Transparency();
+
+        // Whether the driver can render into the float targets, probed when constructed
+        bool isSupported() const { return m_Supported; }
+
+        // Draw transparent surfaces into the targets, which follow the size of the scene. Depth isn't tested
+        void begin(int width, int height);
+        // Blend them over the scene and restore its framebuffer and render state
+        void end();
+};
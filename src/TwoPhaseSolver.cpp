@@ -0,0 +1,367 @@
+#include <TwoPhaseSolver.h>
+
+#include <CubeCoordinates.h>
+
+#include <algorithm>
+
+static const int TWISTS = 2187;     // 3^7
+static const int FLIPS = 2048;      // 2^11
+static const int SLICES = 495;      // 12 choose 4, slots of the middle layer edges
+static const int CORNER_PERMUTATIONS = 40320;
+static const int EDGE_PERMUTATIONS = 40320;  // the 8 U and D layer edges in phase 2
+static const int SLICE_PERMUTATIONS = 24;
+static const int LAYER_COMBINATIONS = 70;    // 8 choose 4, slots of the U layer corners or edges in phase 2
+
+// First middle layer edge, see the edge order of CubeState.cpp
+static const int SLICE_EDGE = 8;
+
+// Slots 8-11 hold the middle layer edges when solved, slots 0-3 the U layer pieces
+static const int SLICE_SOLVED = 494;
+static const int LAYER_SOLVED = 0;
+
+// Phase 2 first only looks for short completions of many phase 1 solutions, which finds short solutions faster
+static const int PHASE2_SEARCH_DEPTH = 12;
+
+// U, U2, U', D, D2, D', F2, B2, L2, R2
+static const int PHASE2_MOVE_COUNT = 10;
+static const int PHASE2_MOVES[PHASE2_MOVE_COUNT] = { 12, 13, 14, 15, 16, 17, 1, 4, 7, 10 };
+
+// Turning the same face twice in a row is never shorter, and opposite faces commute so only one order is searched
+static bool isRedundant(int face, int lastFace)
+{
+    return lastFace >= 0 && (face == lastFace || (face / 2 == lastFace / 2 && face < lastFace));
+}
+
+static bool isPhase2Move(int move)
+{
+    return move / 3 == 4 || move / 3 == 5 || move % 3 == 1;
+}
+
+static int binomial(int n, int k)
+{
+    if(k < 0 || k > n) { return 0; }
+    int result = 1;
+    for(int i = 0; i < k; i++) {
+        result = result * (n - i) / (i + 1);
+    }
+    return result;
+}
+
+// Combinatorial number system over the slots holding middle layer edges
+static int rankSlice(const uint8_t* ep)
+{
+    int index = 0;
+    for(int slot = 0, k = 0; slot < EDGE_COUNT; slot++) {
+        if(ep[slot] >= SLICE_EDGE) { index += binomial(slot, ++k); }
+    }
+    return index;
+}
+
+static void unrankSlice(int index, uint8_t* ep)
+{
+    bool slice[EDGE_COUNT] = {};
+    for(int k = 4; k >= 1; k--) {
+        int slot = k - 1;
+        while(binomial(slot + 1, k) <= index) {
+            slot++;
+        }
+        index -= binomial(slot, k);
+        slice[slot] = true;
+    }
+    for(int slot = 0, other = 0, middle = SLICE_EDGE; slot < EDGE_COUNT; slot++) {
+        ep[slot] = slice[slot] ? middle++ : other++;
+    }
+}
+
+// Slots of the U layer pieces among the 8 U and D layer slots, for corners or edges
+static int rankLayer(const uint8_t* pieces)
+{
+    int index = 0;
+    for(int slot = 0, k = 0; slot < 8; slot++) {
+        if(pieces[slot] < 4) { index += binomial(slot, ++k); }
+    }
+    return index;
+}
+
+static void unrankLayer(int index, uint8_t* pieces)
+{
+    bool up[8] = {};
+    for(int k = 4; k >= 1; k--) {
+        int slot = k - 1;
+        while(binomial(slot + 1, k) <= index) {
+            slot++;
+        }
+        index -= binomial(slot, k);
+        up[slot] = true;
+    }
+    for(int slot = 0, upper = 0, lower = 4; slot < 8; slot++) {
+        pieces[slot] = up[slot] ? upper++ : lower++;
+    }
+}
+
+static int rankSlicePermutation(const uint8_t* ep)
+{
+    uint8_t permutation[4];
+    for(int i = 0; i < 4; i++) {
+        permutation[i] = ep[SLICE_EDGE + i] - SLICE_EDGE;
+    }
+    return RankPermutation(permutation, 4);
+}
+
+// Pruning distances packed two per byte, capped at 15 so they still never overestimate: half the cache footprint
+class PruneTable
+{
+    private:
+        std::vector<uint8_t> m_Nibbles;
+    public:
+        PruneTable() = default;
+        PruneTable(const std::vector<uint8_t>& distances)
+            : m_Nibbles((distances.size() + 1) / 2, 0)
+        {
+            for(size_t i = 0; i < distances.size(); i++) {
+                m_Nibbles[i / 2] |= std::min<uint8_t>(distances[i], 15) << (4 * (i & 1));
+            }
+        }
+
+        int operator[](size_t index) const { return (m_Nibbles[index / 2] >> (4 * (index & 1))) & 15; }
+};
+
+struct TwoPhaseTables
+{
+    // Phase 1, [coordinate * MOVE_COUNT + move]
+    std::vector<uint16_t> twistMove, flipMove, sliceMove;
+    // Phase 2, [coordinate * PHASE2_MOVE_COUNT + index in PHASE2_MOVES]
+    std::vector<uint16_t> cornerMove, edgeMove, slicePermutationMove, cornerLayerMove, edgeLayerMove;
+
+    // Distances to the goal of each phase over pairs of coordinates, their maximum is the phase heuristic.
+    // Phase 2 pairs each permutation with the layer split of the other kind of pieces.
+    PruneTable twistSlicePrune, flipSlicePrune, twistFlipPrune;
+    PruneTable cornerSlicePrune, edgeSlicePrune, cornerEdgeLayerPrune, edgeCornerLayerPrune;
+
+    TwoPhaseTables();
+};
+
+// Build a move table by applying each move to a representative state of every coordinate
+template<typename Unrank, typename Rank>
+static std::vector<uint16_t> buildMoveTable(int size, const int* moves, int moveCount, Unrank unrank, Rank rank)
+{
+    std::vector<uint16_t> table(size * moveCount);
+    for(int c = 0; c < size; c++) {
+        CubeState state = CubeState::solved();
+        unrank(c, state);
+        for(int m = 0; m < moveCount; m++) {
+            table[c * moveCount + m] = rank(state.multiply(CubeState::moveState(moves[m])));
+        }
+    }
+    return table;
+}
+
+// Breadth-first distances over the product of two coordinates, 0xFF before a pair is reached
+static std::vector<uint8_t> buildPruneTable(int sizeA, const std::vector<uint16_t>& moveA, int sizeB, const std::vector<uint16_t>& moveB,
+    int moveCount, int solvedA, int solvedB)
+{
+    std::vector<uint8_t> table(sizeA * sizeB, 0xFF);
+    table[solvedA * sizeB + solvedB] = 0;
+    for(int depth = 0, found = 1; found > 0; depth++) {
+        found = 0;
+        for(int i = 0; i < sizeA * sizeB; i++) {
+            if(table[i] != depth) { continue; }
+            int a = i / sizeB, b = i % sizeB;
+            for(int m = 0; m < moveCount; m++) {
+                int next = moveA[a * moveCount + m] * sizeB + moveB[b * moveCount + m];
+                if(table[next] == 0xFF) {
+                    table[next] = depth + 1;
+                    found++;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+TwoPhaseTables::TwoPhaseTables()
+{
+    int allMoves[MOVE_COUNT];
+    for(int m = 0; m < MOVE_COUNT; m++) {
+        allMoves[m] = m;
+    }
+
+    twistMove = buildMoveTable(TWISTS, allMoves, MOVE_COUNT,
+        [](int c, CubeState& s) { UnrankOrientation(c, s.co, CORNER_COUNT, 3); },
+        [](const CubeState& s) { return RankOrientation(s.co, CORNER_COUNT, 3); });
+    flipMove = buildMoveTable(FLIPS, allMoves, MOVE_COUNT,
+        [](int c, CubeState& s) { UnrankOrientation(c, s.eo, EDGE_COUNT, 2); },
+        [](const CubeState& s) { return RankOrientation(s.eo, EDGE_COUNT, 2); });
+    sliceMove = buildMoveTable(SLICES, allMoves, MOVE_COUNT,
+        [](int c, CubeState& s) { unrankSlice(c, s.ep); },
+        [](const CubeState& s) { return rankSlice(s.ep); });
+
+    cornerMove = buildMoveTable(CORNER_PERMUTATIONS, PHASE2_MOVES, PHASE2_MOVE_COUNT,
+        [](int c, CubeState& s) { UnrankPermutation(c, s.cp, CORNER_COUNT); },
+        [](const CubeState& s) { return RankPermutation(s.cp, CORNER_COUNT); });
+    edgeMove = buildMoveTable(EDGE_PERMUTATIONS, PHASE2_MOVES, PHASE2_MOVE_COUNT,
+        [](int c, CubeState& s) { UnrankPermutation(c, s.ep, SLICE_EDGE); },
+        [](const CubeState& s) { return RankPermutation(s.ep, SLICE_EDGE); });
+    slicePermutationMove = buildMoveTable(SLICE_PERMUTATIONS, PHASE2_MOVES, PHASE2_MOVE_COUNT,
+        [](int c, CubeState& s) {
+            UnrankPermutation(c, s.ep + SLICE_EDGE, 4);
+            for(int i = SLICE_EDGE; i < EDGE_COUNT; i++) {
+                s.ep[i] += SLICE_EDGE;
+            }
+        },
+        [](const CubeState& s) { return rankSlicePermutation(s.ep); });
+    cornerLayerMove = buildMoveTable(LAYER_COMBINATIONS, PHASE2_MOVES, PHASE2_MOVE_COUNT,
+        [](int c, CubeState& s) { unrankLayer(c, s.cp); },
+        [](const CubeState& s) { return rankLayer(s.cp); });
+    edgeLayerMove = buildMoveTable(LAYER_COMBINATIONS, PHASE2_MOVES, PHASE2_MOVE_COUNT,
+        [](int c, CubeState& s) { unrankLayer(c, s.ep); },
+        [](const CubeState& s) { return rankLayer(s.ep); });
+
+    twistSlicePrune = buildPruneTable(TWISTS, twistMove, SLICES, sliceMove, MOVE_COUNT, 0, SLICE_SOLVED);
+    flipSlicePrune = buildPruneTable(FLIPS, flipMove, SLICES, sliceMove, MOVE_COUNT, 0, SLICE_SOLVED);
+    twistFlipPrune = buildPruneTable(TWISTS, twistMove, FLIPS, flipMove, MOVE_COUNT, 0, 0);
+    cornerSlicePrune = buildPruneTable(CORNER_PERMUTATIONS, cornerMove, SLICE_PERMUTATIONS, slicePermutationMove, PHASE2_MOVE_COUNT, 0, 0);
+    edgeSlicePrune = buildPruneTable(EDGE_PERMUTATIONS, edgeMove, SLICE_PERMUTATIONS, slicePermutationMove, PHASE2_MOVE_COUNT, 0, 0);
+    cornerEdgeLayerPrune = buildPruneTable(CORNER_PERMUTATIONS, cornerMove, LAYER_COMBINATIONS, edgeLayerMove, PHASE2_MOVE_COUNT, 0, LAYER_SOLVED);
+    edgeCornerLayerPrune = buildPruneTable(EDGE_PERMUTATIONS, edgeMove, LAYER_COMBINATIONS, cornerLayerMove, PHASE2_MOVE_COUNT, 0, LAYER_SOLVED);
+}
+
+static const TwoPhaseTables& tables()
+{
+    static const TwoPhaseTables instance;
+    return instance;
+}
+
+static int phase1Estimate(const TwoPhaseTables& t, int twist, int flip, int slice)
+{
+    int estimate = std::max(t.twistSlicePrune[twist * SLICES + slice], t.flipSlicePrune[flip * SLICES + slice]);
+    return std::max(estimate, t.twistFlipPrune[twist * FLIPS + flip]);
+}
+
+static int phase2Estimate(const TwoPhaseTables& t, const Phase2Coords& c)
+{
+    int estimate = std::max(t.cornerSlicePrune[c.corners * SLICE_PERMUTATIONS + c.slice], t.edgeSlicePrune[c.edges * SLICE_PERMUTATIONS + c.slice]);
+    int layers = std::max(t.cornerEdgeLayerPrune[c.corners * LAYER_COMBINATIONS + c.edgeLayer],
+        t.edgeCornerLayerPrune[c.edges * LAYER_COMBINATIONS + c.cornerLayer]);
+    return std::max(estimate, layers);
+}
+
+////////////////////
+// TwoPhaseSolver //
+////////////////////
+
+TwoPhaseSolver::TwoPhaseSolver()
+{
+    tables();
+}
+
+bool TwoPhaseSolver::solve(const CubeState& state, std::vector<int>& moves, int maxLength)
+{
+    moves.clear();
+    m_Nodes = 0;
+    if(!state.isSolvable()) { return false; }
+
+    m_Start = state;
+    m_MaxLength = std::min(maxLength, TWO_PHASE_MAX_LENGTH);
+
+    int twist = RankOrientation(state.co, CORNER_COUNT, 3);
+    int flip = RankOrientation(state.eo, EDGE_COUNT, 2);
+    int slice = rankSlice(state.ep);
+    int estimate = phase1Estimate(tables(), twist, flip, slice);
+
+    // First with short phase 2 searches only, then without limit if that found nothing short enough
+    for(int phase2Limit : { PHASE2_SEARCH_DEPTH, PHASE2_MAX_DEPTH }) {
+        m_Phase2Limit = phase2Limit;
+        for(int length = estimate; length <= std::min(PHASE1_MAX_DEPTH, m_MaxLength); length++) {
+            if(phase1(twist, flip, slice, 0, length, -1)) {
+                moves.assign(m_Path, m_Path + m_Length);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TwoPhaseSolver::phase1(int twist, int flip, int slice, int depth, int remaining, int lastFace)
+{
+    m_Nodes++;
+    if(remaining == 0) {
+        // A phase 2 move at the end means the same subgroup state was reached by a shorter phase 1
+        if(depth > 0 && isPhase2Move(m_Path[depth - 1])) { return false; }
+        return startPhase2(depth);
+    }
+
+    const TwoPhaseTables& t = tables();
+    for(int move = 0; move < MOVE_COUNT; move++) {
+        int face = move / 3;
+        if(isRedundant(face, lastFace)) { continue; }
+        // The last phase 1 move can't be a phase 2 move, see above
+        if(remaining == 1 && isPhase2Move(move)) { continue; }
+
+        // Coordinates are only looked up once the previous pruning test passed
+        int nextTwist = t.twistMove[twist * MOVE_COUNT + move];
+        int nextSlice = t.sliceMove[slice * MOVE_COUNT + move];
+        if(t.twistSlicePrune[nextTwist * SLICES + nextSlice] >= remaining) { continue; }
+        int nextFlip = t.flipMove[flip * MOVE_COUNT + move];
+        if(t.flipSlicePrune[nextFlip * SLICES + nextSlice] >= remaining || t.twistFlipPrune[nextTwist * FLIPS + nextFlip] >= remaining) { continue; }
+
+        m_Path[depth] = move;
+        if(phase1(nextTwist, nextFlip, nextSlice, depth + 1, remaining - 1, face)) { return true; }
+    }
+    return false;
+}
+
+bool TwoPhaseSolver::startPhase2(int phase1Length)
+{
+    // Permutation coordinates aren't tracked in phase 1, read them from the state at its end
+    CubeState state = m_Start;
+    for(int i = 0; i < phase1Length; i++) {
+        state.applyMove(m_Path[i]);
+    }
+
+    Phase2Coords coords;
+    coords.corners = RankPermutation(state.cp, CORNER_COUNT);
+    coords.edges = RankPermutation(state.ep, SLICE_EDGE);
+    coords.slice = rankSlicePermutation(state.ep);
+    coords.cornerLayer = rankLayer(state.cp);
+    coords.edgeLayer = rankLayer(state.ep);
+    int estimate = phase2Estimate(tables(), coords);
+
+    int lastFace = phase1Length > 0 ? m_Path[phase1Length - 1] / 3 : -1;
+    int budget = std::min(m_Phase2Limit, m_MaxLength - phase1Length);
+    if(estimate > budget) { return false; }
+    // Any completion within the budget will do: one depth-first pass instead of deepening, most starts fail anyway
+    return phase2(coords, phase1Length, budget, lastFace);
+}
+
+bool TwoPhaseSolver::phase2(const Phase2Coords& coords, int depth, int remaining, int lastFace)
+{
+    m_Nodes++;
+    if(coords.corners == 0 && coords.edges == 0 && coords.slice == 0) {
+        m_Length = depth;
+        return true;
+    }
+
+    const TwoPhaseTables& t = tables();
+    for(int m = 0; m < PHASE2_MOVE_COUNT; m++) {
+        int move = PHASE2_MOVES[m];
+        int face = move / 3;
+        if(isRedundant(face, lastFace)) { continue; }
+
+        // Coordinates are only looked up once the previous pruning test passed
+        Phase2Coords next;
+        next.corners = t.cornerMove[coords.corners * PHASE2_MOVE_COUNT + m];
+        next.slice = t.slicePermutationMove[coords.slice * PHASE2_MOVE_COUNT + m];
+        if(t.cornerSlicePrune[next.corners * SLICE_PERMUTATIONS + next.slice] >= remaining) { continue; }
+        next.edges = t.edgeMove[coords.edges * PHASE2_MOVE_COUNT + m];
+        if(t.edgeSlicePrune[next.edges * SLICE_PERMUTATIONS + next.slice] >= remaining) { continue; }
+        next.cornerLayer = t.cornerLayerMove[coords.cornerLayer * PHASE2_MOVE_COUNT + m];
+        next.edgeLayer = t.edgeLayerMove[coords.edgeLayer * PHASE2_MOVE_COUNT + m];
+        if(t.cornerEdgeLayerPrune[next.corners * LAYER_COMBINATIONS + next.edgeLayer] >= remaining
+            || t.edgeCornerLayerPrune[next.edges * LAYER_COMBINATIONS + next.cornerLayer] >= remaining) { continue; }
+
+        m_Path[depth] = move;
+        if(phase2(next, depth + 1, remaining - 1, face)) { return true; }
+    }
+    return false;
+}
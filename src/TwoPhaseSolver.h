@@ -0,0 +1,48 @@
+#pragma once
+
+#include <CubeState.h>
+
+#include <vector>
+
+// Longest solutions of each phase: phase 1 reaches <U, D, R2, L2, F2, B2> in at most 12 moves, phase 2 solves it in 18
+static constexpr int PHASE1_MAX_DEPTH = 12;
+static constexpr int PHASE2_MAX_DEPTH = 18;
+static constexpr int TWO_PHASE_MAX_LENGTH = PHASE1_MAX_DEPTH + PHASE2_MAX_DEPTH;
+
+// Permutation coordinates of phase 2, see TwoPhaseSolver.cpp
+struct Phase2Coords
+{
+    int corners, edges, slice, cornerLayer, edgeLayer;
+};
+
+/*
+Kociemba's two-phase algorithm: phase 1 brings the cube into the subgroup where corners and edges are oriented and
+the middle layer edges are in the middle layer, phase 2 solves it with U, D and half turns of the other faces.
+Phase 1 is IDA* over coordinate move tables, phase 2 a depth-first search for any completion within the remaining
+moves, both pruned with the maximum of several pruning tables. The tables (~7 MB) are built once, on the
+construction of the first solver. Not thread safe, use one solver per thread.
+*/
+class TwoPhaseSolver
+{
+    private:
+        CubeState m_Start;
+        int m_MaxLength = TWO_PHASE_MAX_LENGTH;
+        int m_Path[TWO_PHASE_MAX_LENGTH];
+        int m_Length = 0;
+        int m_Phase2Limit = PHASE2_MAX_DEPTH;
+        unsigned long long m_Nodes = 0;
+
+        bool phase1(int twist, int flip, int slice, int depth, int remaining, int lastFace);
+        bool startPhase2(int phase1Length);
+        bool phase2(const Phase2Coords& coords, int depth, int remaining, int lastFace);
+
+    public:
+        TwoPhaseSolver();
+
+        // First solution of at most maxLength moves, false if the state isn't solvable or none was found.
+        // Lower limits give shorter solutions at the cost of exploring more phase 1 solutions.
+        bool solve(const CubeState& state, std::vector<int>& moves, int maxLength = TWO_PHASE_MAX_LENGTH);
+
+        // Nodes visited by the last solve, both phases
+        unsigned long long getNodeCount() const { return m_Nodes; }
+};
@@ -1,5 +1,8 @@
 #include <VertexArray.h>
 #include <VertexBufferLayout.h>
+#include <RenderState.h>
+
+#include <unordered_map>
 
 VertexArray::VertexArray()
 {
@@ -8,30 +11,59 @@ VertexArray::VertexArray()
 
 VertexArray::~VertexArray()
 {
+    RenderState::getInstance().forget(RenderBinding::VertexArray, m_RendererID);
     GLCall(glDeleteVertexArrays(1, &m_RendererID));
 }
         
 void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+{
+    const auto& elements = layout.GetElements();
+    AddAttributes(vb, elements.data(), (unsigned int)elements.size(), layout.GetStride(), 0, 0);
+}
+
+void VertexArray::AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute)
+{
+    const auto& elements = layout.GetElements();
+    AddAttributes(vb, elements.data(), (unsigned int)elements.size(), layout.GetStride(), firstAttribute, 1);
+}
+
+void VertexArray::AddAttributes(const VertexBuffer& vb, const VertexBufferElement* elements, unsigned int count, unsigned int stride,
+    unsigned int firstAttribute, unsigned int divisor)
 {
     Bind();
     vb.Bind();
-    const auto& elements = layout.GetElements();
-    unsigned int offset = 0;
-    for (unsigned int i = 0; i < elements.size(); i ++)
+    for (unsigned int i = 0; i < count; i ++)
     {
         const auto& element = elements[i];
-        GLCall(glEnableVertexAttribArray(i));
-        GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void*) (uintptr_t) offset));
-        offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+        GLCall(glEnableVertexAttribArray(firstAttribute + i));
+        GLCall(glVertexAttribPointer(firstAttribute + i, element.count, element.type, element.normalized, stride, (const void*) (uintptr_t) element.offset));
+        if (divisor)
+        {
+            GLCall(glVertexAttribDivisor(firstAttribute + i, divisor));
+        }
     }
 }
 
+// Weak references, a shared vertex array goes away with its last user
+static std::unordered_map<uint64_t, std::weak_ptr<VertexArray>> s_Shared;
+
+std::shared_ptr<VertexArray> VertexArray::FindShared(uint64_t key)
+{
+    auto it = s_Shared.find(key);
+    return it != s_Shared.end() ? it->second.lock() : nullptr;
+}
+
+void VertexArray::RegisterShared(uint64_t key, const std::shared_ptr<VertexArray>& va)
+{
+    s_Shared[key] = va;
+}
+
 void VertexArray::Bind() const
 {
-    GLCall(glBindVertexArray(m_RendererID));
+    RenderState::getInstance().bindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const
 {
-    GLCall(glBindVertexArray(0));
+    RenderState::getInstance().bindVertexArray(0);
 }
\ No newline at end of file
@@ -4,17 +4,57 @@
 #include <VertexBuffer.h>
 #include <VertexBufferLayout.h>
 
+#include <memory>
+
 // VAO
 class VertexArray
 {
     private:
         unsigned int m_RendererID;
+
+        void AddAttributes(const VertexBuffer& vb, const VertexBufferElement* elements, unsigned int count, unsigned int stride,
+            unsigned int firstAttribute, unsigned int divisor);
+
+        // Vertex array registered under `key`, null when there is none alive
+        static std::shared_ptr<VertexArray> FindShared(uint64_t key);
+        static void RegisterShared(uint64_t key, const std::shared_ptr<VertexArray>& va);
     public:
         VertexArray();
         ~VertexArray();
         
         void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+        template<size_t N>
+        void AddBuffer(const VertexBuffer& vb, const VertexFormat<N>& format)
+        {
+            AddAttributes(vb, format.GetElements(), format.GetCount(), format.GetStride(), 0, 0);
+        }
+
+        // Attributes advanced once per instance instead of once per vertex, starting at attribute `firstAttribute`
+        void AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute);
+        template<size_t N>
+        void AddInstanceBuffer(const VertexBuffer& vb, const VertexFormat<N>& format, unsigned int firstAttribute)
+        {
+            AddAttributes(vb, format.GetElements(), format.GetCount(), format.GetStride(), firstAttribute, 1);
+        }
+
+        /*
+        Vertex array reading `vb` (null for none) with `format`, shared by every mesh drawn from the same buffer and
+        format: it is looked up by the hash of the format and the buffer name, and created on the first request.
+        The buffer has to outlive the vertex array, and a shared vertex array must not get more buffers added.
+        */
+        template<size_t N>
+        static std::shared_ptr<VertexArray> GetShared(const VertexBuffer* vb, const VertexFormat<N>& format)
+        {
+            uint64_t key = (format.GetHash() ^ (vb ? vb->GetRendererID() : 0)) * 1099511628211ull;
+            std::shared_ptr<VertexArray> va = FindShared(key);
+            if(!va) {
+                va = std::make_shared<VertexArray>();
+                if(vb) { va->AddBuffer(*vb, format); }
+                RegisterShared(key, va);
+            }
+            return va;
+        }
 
         void Bind() const;
         void Unbind() const;
-};
\ No newline at end of file
+};
@@ -8,9 +8,14 @@ class VertexBuffer
     private:
         unsigned int m_RendererID;
     public:
-        VertexBuffer(const void* data, unsigned int size);
+        VertexBuffer(const void* data, unsigned int size, unsigned int usage = GL_STATIC_DRAW);
         ~VertexBuffer();
 
+        // Overwrite part of the buffer, meant for buffers created with GL_DYNAMIC_DRAW
+        void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
         void Bind() const;
         void Unbind() const;
+
+        inline unsigned int GetRendererID() const { return m_RendererID; }
 };
\ No newline at end of file
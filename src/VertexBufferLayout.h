@@ -4,6 +4,11 @@
 
 #include <Debugger.h>
 
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 struct VertexBufferElement
@@ -11,8 +16,9 @@ struct VertexBufferElement
     unsigned int type;
     unsigned int count;
     unsigned char normalized;
+    unsigned int offset;    // bytes from the start of the vertex
 
-    static unsigned int GetSizeOfType(unsigned int type)
+    static constexpr unsigned int GetSizeOfType(unsigned int type)
     {
         switch (type)
         {
@@ -22,12 +28,29 @@ struct VertexBufferElement
             return 4;
         case GL_UNSIGNED_BYTE:
             return 1;
+        case GL_HALF_FLOAT:
+            return 2;
         }
         ASSERT(false);
         return 0;
     }
 };
 
+// FNV-1a over the elements and the stride, equal layouts hash equal whether built at compile time or by Push
+constexpr uint64_t HashVertexLayout(const VertexBufferElement* elements, size_t count, unsigned int stride)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+    for(size_t i = 0; i < count; i++) {
+        mix(elements[i].type);
+        mix(elements[i].count);
+        mix(elements[i].normalized);
+        mix(elements[i].offset);
+    }
+    mix(stride);
+    return hash;
+}
+
 class VertexBufferLayout
 {
     private:
@@ -44,27 +67,86 @@ class VertexBufferLayout
             static_assert(sizeof(T) == 0, "Unsupported type!");
         }
 
-        inline const std::vector<VertexBufferElement> GetElements() const { return m_Elements; }
+        inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
         inline unsigned int GetStride() const { return m_Stride; }
+        inline uint64_t GetHash() const { return HashVertexLayout(m_Elements.data(), m_Elements.size(), m_Stride); }
 };
 
 template<>
 inline void VertexBufferLayout::Push<float>(unsigned int count)
 {
-    m_Elements.push_back({ GL_FLOAT, count, GL_FALSE });
+    m_Elements.push_back({ GL_FLOAT, count, GL_FALSE, m_Stride });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
 }
 
 template<>
 inline void VertexBufferLayout::Push<unsigned int>(unsigned int count)
 {
-    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
+    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, m_Stride });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
 }
 
 template<>
 inline void VertexBufferLayout::Push<unsigned char>(unsigned int count)
 {
-    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
+    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE, m_Stride });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
-}
\ No newline at end of file
+}
+
+// Packed attributes, filled with glm/gtc/packing.hpp (packHalf1x16, packSnorm3x10_1x2); shaders read them as floats
+struct Half2 { uint16_t value[2]; };
+struct Half4 { uint16_t value[4]; };
+struct PackedNormal { uint32_t value; };    // signed normalized 10-10-10 bits, x lowest, 2 unused bits on top
+
+// GL type of a vertex struct member, left undefined for the unsupported ones
+template<typename T> struct VertexAttributeType;
+template<> struct VertexAttributeType<float> { static constexpr unsigned int type = GL_FLOAT, count = 1, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<glm::vec2> { static constexpr unsigned int type = GL_FLOAT, count = 2, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<glm::vec3> { static constexpr unsigned int type = GL_FLOAT, count = 3, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<glm::vec4> { static constexpr unsigned int type = GL_FLOAT, count = 4, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<unsigned int> { static constexpr unsigned int type = GL_UNSIGNED_INT, count = 1, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<glm::u8vec4> { static constexpr unsigned int type = GL_UNSIGNED_BYTE, count = 4, normalized = GL_TRUE; };
+template<> struct VertexAttributeType<Half2> { static constexpr unsigned int type = GL_HALF_FLOAT, count = 2, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<Half4> { static constexpr unsigned int type = GL_HALF_FLOAT, count = 4, normalized = GL_FALSE; };
+template<> struct VertexAttributeType<PackedNormal> { static constexpr unsigned int type = GL_INT_2_10_10_10_REV, count = 4, normalized = GL_TRUE; };
+
+template<typename T>
+constexpr VertexBufferElement MakeVertexElement(unsigned int offset)
+{
+    using Attribute = VertexAttributeType<T>;
+    return { Attribute::type, Attribute::count, (unsigned char)Attribute::normalized, offset };
+}
+
+// Element of the `member` of the vertex struct, at its offset in the struct
+#define VERTEX_ATTRIBUTE(Vertex, member) MakeVertexElement<decltype(Vertex::member)>((unsigned int)offsetof(Vertex, member))
+
+/*
+Vertex layout known at compile time, built from the members of a vertex struct:
+    static constexpr auto FORMAT = MakeVertexFormat<Vertex>(VERTEX_ATTRIBUTE(Vertex, position), ...);
+The stride is the size of the struct, offsets come from offsetof, so the layout can't drift from the struct.
+*/
+template<size_t N>
+class VertexFormat
+{
+    private:
+        std::array<VertexBufferElement, N> m_Elements;
+        unsigned int m_Stride;
+        uint64_t m_Hash;
+    public:
+        constexpr VertexFormat(const std::array<VertexBufferElement, N>& elements, unsigned int stride)
+            : m_Elements(elements), m_Stride(stride), m_Hash(HashVertexLayout(elements.data(), N, stride)) {}
+
+        constexpr const VertexBufferElement* GetElements() const { return m_Elements.data(); }
+        constexpr unsigned int GetCount() const { return (unsigned int)N; }
+        constexpr unsigned int GetStride() const { return m_Stride; }
+        constexpr uint64_t GetHash() const { return m_Hash; }
+};
+
+template<typename Vertex, typename... Elements>
+constexpr VertexFormat<sizeof...(Elements)> MakeVertexFormat(Elements... elements)
+{
+    return VertexFormat<sizeof...(Elements)>({ { elements... } }, (unsigned int)sizeof(Vertex));
+}
+
+// Format of draws without vertex attributes, e.g. the fullscreen triangle generated from gl_VertexID
+static constexpr VertexFormat<0> EMPTY_VERTEX_FORMAT({}, 0);
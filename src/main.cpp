@@ -11,7 +11,21 @@
 #include <Shader.h>
 #include <Texture.h>
 #include <Camera.h>
-
+#include <CubeRenderer.h>
+#include <Profiler.h>
+#include <RenderBenchmark.h>
+#include <OptimalSolver.h>
+#include <BackgroundScrambler.h>
+#include <Notation.h>
+#include <Replay.h>
+#include <FrameScheduler.h>
+#include <CubeAnimator.h>
+#include <RenderState.h>
+#include <FrameArena.h>
+#include <AmbientOcclusion.h>
+#include <AntiAliasing.h>
+
+#include <ctime>
 #include <iostream>
 
 #include "RubiksCube.h"
@@ -22,78 +36,20 @@ const unsigned int height = 800;
 const float FOVdegree = 45.0f;  // Field Of View Angle
 const float near = 0.1f;
 const float far = 100.0f;
-
-// Cube mesh vertices and indices
-float vertices[] = {
-    // positions           // colors           // texCoords
-
-    // Front Face (z=0.5f, in front of camera)  // white (opposite of yellow)
-    -0.5f, -0.5f, 0.5f,    1.0f, 1.0f, 1.0f,   0.0f, 0.0f, // Front-bottom-left
-     0.5f, -0.5f, 0.5f,    1.0f, 1.0f, 1.0f,   1.0f, 0.0f, // Front-bottom-right
-     0.5f,  0.5f, 0.5f,    1.0f, 1.0f, 1.0f,   1.0f, 1.0f, // Front-top-right
-    -0.5f,  0.5f, 0.5f,    1.0f, 1.0f, 1.0f,   0.0f, 1.0f, // Front-top-left
-
-    // Back Face (z=0.5f, behind camera)  // yellow (opposite of white)
-    -0.5f, -0.5f, -0.5f,   1.0f, 1.0f, 0.0f,   0.0f, 0.0f, // Back-bottom-left
-     0.5f, -0.5f, -0.5f,   1.0f, 1.0f, 0.0f,   1.0f, 0.0f, // Back-bottom-right
-     0.5f,  0.5f, -0.5f,   1.0f, 1.0f, 0.0f,   1.0f, 1.0f, // Back-top-right
-    -0.5f,  0.5f, -0.5f,   1.0f, 1.0f, 0.0f,   0.0f, 1.0f, // Back-top-left
-
-    // Left Face           // blue (opposite of green)
-    -0.5f, -0.5f, -0.5f,   0.0f, 0.0f, 1.0f,   0.0f, 0.0f, // Back-bottom-left
-    -0.5f, -0.5f,  0.5f,   0.0f, 0.0f, 1.0f,   1.0f, 0.0f, // Front-bottom-left
-    -0.5f,  0.5f,  0.5f,   0.0f, 0.0f, 1.0f,   1.0f, 1.0f, // Front-top-left
-    -0.5f,  0.5f, -0.5f,   0.0f, 0.0f, 1.0f,   0.0f, 1.0f, // Back-top-left
-
-    // Right Face          // green (opposite of blue)
-     0.5f, -0.5f,  0.5f,   0.0f, 1.0f, 0.0f,   0.0f, 0.0f, // Back-bottom-right
-     0.5f, -0.5f, -0.5f,   0.0f, 1.0f, 0.0f,   1.0f, 0.0f, // Front-bottom-right
-     0.5f,  0.5f, -0.5f,   0.0f, 1.0f, 0.0f,   1.0f, 1.0f, // Front-top-right
-     0.5f,  0.5f,  0.5f,   0.0f, 1.0f, 0.0f,   0.0f, 1.0f, // Back-top-right
-
-    // Top Face            // orange (opposite of red)
-    -0.5f,  0.5f,  0.5f,   1.0f, 0.5f, 0.0f,   0.0f, 0.0f, // Back-top-left
-     0.5f,  0.5f,  0.5f,   1.0f, 0.5f, 0.0f,   1.0f, 0.0f, // Back-top-right
-     0.5f,  0.5f, -0.5f,   1.0f, 0.5f, 0.0f,   1.0f, 1.0f, // Front-top-right
-    -0.5f,  0.5f, -0.5f,   1.0f, 0.5f, 0.0f,   0.0f, 1.0f, // Front-top-left
-
-    // Bottom Face         // red (opposite of orange)
-    -0.5f, -0.5f, -0.5f,   1.0f, 0.0f, 0.0f,   0.0f, 0.0f, // Back-bottom-left
-     0.5f, -0.5f, -0.5f,   1.0f, 0.0f, 0.0f,   1.0f, 0.0f, // Back-bottom-right
-     0.5f, -0.5f,  0.5f,   1.0f, 0.0f, 0.0f,   1.0f, 1.0f, // Front-bottom-right
-    -0.5f, -0.5f,  0.5f,   1.0f, 0.0f, 0.0f,   0.0f, 1.0f, // Front-bottom-left
-};
-
-unsigned int indices[] = {
-    // Front face
-    0, 1, 2,
-    2, 3, 0,
-
-    // Back face
-    4, 5, 6,
-    6, 7, 4,
-
-    // Left face
-    8, 9, 10,
-    10, 11, 8,
-
-    // Right face
-    12, 13, 14,
-    14, 15, 12,
-
-    // Top face
-    16, 17, 18,
-    18, 19, 16,
-
-    // Bottom face
-    20, 21, 22,
-    22, 23, 20
-};
+const double IDLE_TIMEOUT = 0.5;  // Seconds an idle loop sleeps at most without events
 
 int main(int argc, char* argv[])
 {
     GLFWwindow* window;
 
+    /* Parse benchmark options, see RenderBenchmark.h */
+    RenderBenchmarkOptions options;
+    if (!ParseRenderBenchmarkOptions(argc, argv, options))
+    {
+        return -1;
+    }
+    RenderBenchmark benchmark(options);
+
     /* Initialize the library */
     if (!glfwInit())
     {
@@ -105,6 +61,12 @@ int main(int argc, char* argv[])
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+    /* Benchmarks render headless */
+    if (benchmark.isActive())
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+
     /* Create a windowed mode window and its OpenGL context */
     window = glfwCreateWindow(width, height, "OpenGL", NULL, NULL);
     if (!window)
@@ -119,42 +81,30 @@ int main(int argc, char* argv[])
     /* Load GLAD so it configures OpenGL */
     gladLoadGL();
 
-    /* Control frame rate */
-    glfwSwapInterval(1);
+    /* Control frame rate, benchmarks render as fast as possible */
+    FrameScheduler& scheduler = FrameScheduler::getInstance();
+    scheduler.setSwapInterval(benchmark.isActive() ? 0 : options.swapInterval);
+
+    /* Skip binds of objects already bound, unless disabled to measure the difference */
+    RenderState::getInstance().setCaching(options.stateCache);
 
     /* Print OpenGL version after completing initialization */
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
 
+    /* Set when a --record or --replay file can't be opened */
+    bool failed = false;
+
     /* Set scope so that on widow close the destructors will be called automatically */
     {
         /* Blend to fix images with transperancy */
         GLCall(glEnable(GL_BLEND));
         GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
-        /* Generate VAO, VBO, EBO and bind them */
-        VertexArray va;
-        VertexBuffer vb(vertices, sizeof(vertices));
-        IndexBuffer ib(indices, sizeof(indices));
-
-        VertexBufferLayout layout;
-        layout.Push<float>(3);  // positions
-        layout.Push<float>(3);  // colors
-        layout.Push<float>(2);  // texCoords
-        va.AddBuffer(vb, layout);
-
-        /* Create texture */
-        Texture texture("res/textures/plane.png");
-        texture.Bind();
-         
-        /* Create shaders */
-        Shader shader("res/shaders/basic.shader");
-        shader.Bind();
-
-        /* Unbind all to prevent accidentally modifying them */
-        va.Unbind();
-        vb.Unbind();
-        ib.Unbind();
-        shader.Unbind();
+        /* Create the cubie mesh, textures and shaders */
+        CubeRenderer renderer(options.packedVertices);
+        renderer.setPointLightCount(options.lights);
+        renderer.setXRay(options.xRay);
+        renderer.setTransparencyMode(options.transparency);
 
         /* Enables the Depth Buffer */
     	GLCall(glEnable(GL_DEPTH_TEST));
@@ -163,58 +113,228 @@ int main(int argc, char* argv[])
         Camera camera(width, height);
         camera.setPerspective(FOVdegree, near, far);
         camera.EnableInputs(window);
-        camera.setBuffers(&va, &ib, &shader);
+        camera.setBuffers(renderer.getVertexArray(), renderer.getIndexBuffer(), renderer.getShader());
+
+        RubiksCube& rubiksCube = RubiksCube::getInstance();
+        Profiler& profiler = Profiler::getInstance();
 
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
+        /* Map the pattern databases of the optimal solver (O key) */
+        OptimalSolver& solver = OptimalSolver::getInstance();
+        if (!benchmark.isActive() && !solver.load("res/pdb"))
         {
-            /* Set white background color */
-            GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
-
-            /* Render here */
-            GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
-
-            /* Initialize uniform color */
-            glm::vec4 color = glm::vec4(1.0, 1.0f, 1.0f, 1.0f);
-
-            /* Global cubie scale*/
-            float globalScale = CUBIE_SCALE;
-
-            /* Get Rubik's Cube instance and its cubes */
-            RubiksCube& rubiksCube = RubiksCube::getInstance();
-            Cubie *cubes = rubiksCube.getCubes();
-
-            /* Draw each cubie */
-            for(int i = 0; i < 27; i++) {
-                /* Initialize the model Translate, Rotate and Scale matrices */
-                glm::mat4 trans = glm::translate(glm::mat4(1.0f), cubes[i].position);
-                glm::mat4 rot = cubes[i].rotationMatrix;
-                glm::mat4 scl = glm::scale(glm::mat4(1.0f), glm::vec3(globalScale));
-
-                /* Calculate Model-View-Projection matrix */
-                glm::mat4 model = trans * rot * scl;
-                glm::mat4 view = camera.GetViewMatrix();
-                glm::mat4 proj = camera.GetProjectionMatrix();
-                glm::mat4 mvp = proj * view * model;
-
-                /* Update shaders paramters and draw to the screen */
-                shader.Bind();
-                shader.SetUniform4f("u_Color", color);
-                shader.SetUniformMat4f("u_MVP", mvp);
-                shader.SetUniform1i("u_Texture", 0);
-                va.Bind();
-                ib.Bind();
-                GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));   
+            std::cout << "Pattern databases not found in res/pdb, run \"make pdb\" to enable the optimal solver" << std::endl;
+        }
+
+        if (benchmark.isActive())
+        {
+            benchmark.start(camera, renderer, rubiksCube);
+        }
+
+        /* Apply the --moves sequence, already validated with the options */
+        Algorithm startMoves;
+        if (Algorithm::compile(options.moves, startMoves) && !startMoves.getTurns().empty())
+        {
+            std::cout << "Applying: " << startMoves.toString() << std::endl;
+            startMoves.apply(rubiksCube);
+        }
+
+        /* Record what follows, or play a recording back, leaving before anything else is started when it fails */
+        ReplayRecorder& recorder = ReplayRecorder::getInstance();
+        if (!options.recordPath.empty() && !recorder.start(options.recordPath))
+        {
+            failed = true;
+        }
+        ReplayPlayer player;
+        bool replaying = !options.replayPath.empty();
+        if (!failed && replaying && !player.open(options.replayPath))
+        {
+            failed = true;
+        }
+
+        /* Build the tables of the scrambler (S key) in the background */
+        BackgroundScrambler& scrambler = BackgroundScrambler::getInstance();
+        if (!failed && !benchmark.isActive())
+        {
+            scrambler.start((uint64_t)time(nullptr));
+        }
+
+        if (!failed)
+        {
+            /* Offscreen multisampled scene, resolved into the window */
+            AntiAliasing antiAliasing(options.msaaSamples, options.fxaa);
+            std::cout << "MSAA: " << antiAliasing.getSamples() << " sample(s), FXAA: " << (antiAliasing.isFxaaEnabled() ? "on" : "off") << std::endl;
+
+            /* Contact darkening between the cubies, G toggles it */
+            AmbientOcclusion occlusion(options.ssao);
+            antiAliasing.setAmbientOcclusion(&occlusion);
+
+            /* Render toggles polled each frame: G for the ambient occlusion, X for see-through cubies */
+            bool occlusionKeyDown = false, xRayKeyDown = false;
+            auto keyPressed = [window](int key, bool& down) {
+                bool pressed = glfwGetKey(window, key) == GLFW_PRESS;
+                bool wasDown = down;
+                down = pressed;
+                return pressed && !wasDown;
+            };
+
+            /* Turns are animated, except in benchmarks which draw the cube as it is */
+            CubeAnimator animator;
+            bool animated = !benchmark.isActive();
+
+            /* A solution found in the background wakes the loop up when it is idle */
+            solver.setOnSolved([]() { glfwPostEmptyEvent(); });
+            scrambler.setOnReady([]() { glfwPostEmptyEvent(); });
+
+            /* Frames are only drawn when something changed since the last one, otherwise the loop sleeps until an event */
+            unsigned long long drawnCube = 0, drawnCamera = 0;
+            bool drawn = false;
+            bool idle = false;
+
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                if (benchmark.isActive() && benchmark.isDone())
+                {
+                    break;
+                }
+
+                if (idle)
+                {
+                    scheduler.waitInput(IDLE_TIMEOUT);
+                }
+
+                scheduler.beginFrame();
+                float step = (float)FrameScheduler::getStep();
+
+                /* Fixed-timestep simulation: replay playback ([ and ] scrub it backward and forward at 10x) and turn animations */
+                float scrub = 0.0f;
+                if (replaying)
+                {
+                    scrub = (glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS ? 10.0f : 0.0f)
+                        - (glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS ? 10.0f : 0.0f);
+                }
+                for (int i = 0; i < scheduler.getStepCount(); i++)
+                {
+                    if (replaying)
+                    {
+                        if (scrub != 0.0f)
+                        {
+                            player.seek(player.getPosition() + scrub * step, rubiksCube);
+                            animator.snap(rubiksCube.getCubes());
+                        }
+                        else
+                        {
+                            player.advance(step * options.replaySpeed, rubiksCube);
+                        }
+                    }
+                    animator.step(rubiksCube.getCubes(), step);
+                }
+
+                /* Poll input as late as possible, right before drawing */
+                scheduler.pollInput();
+
+                bool occlusionToggled = keyPressed(GLFW_KEY_G, occlusionKeyDown);
+                if (occlusionToggled)
+                {
+                    occlusion.setEnabled(!occlusion.isEnabled());
+                    std::cout << "SSAO: " << (occlusion.isEnabled() ? "on" : "off") << std::endl;
+                }
+                bool xRayToggled = keyPressed(GLFW_KEY_X, xRayKeyDown);
+                if (xRayToggled)
+                {
+                    renderer.setXRay(!renderer.isXRay());
+                    std::cout << "X-ray: " << (renderer.isXRay() ? "on" : "off") << std::endl;
+                }
+
+                /* Apply the solution once the background solve finished */
+                std::vector<int> solution;
+                if (solver.pollSolution(solution))
+                {
+                    for (int move : solution)
+                    {
+                        rubiksCube.applyMove(move);
+                        recorder.record(ReplayEventType::ApplyMove, move);
+                    }
+                }
+
+                /* Apply a scramble from solved once it was generated */
+                std::vector<int> scramble;
+                if (scrambler.pollScramble(scramble))
+                {
+                    std::cout << "Scramble: " << FormatMoves(scramble) << std::endl;
+                    rubiksCube.reset();
+                    recorder.record(ReplayEventType::Reset);
+                    for (int move : scramble)
+                    {
+                        rubiksCube.applyMove(move);
+                        recorder.record(ReplayEventType::ApplyMove, move);
+                    }
+                }
+
+                /* Follow the benchmark camera path and move script */
+                if (benchmark.isActive())
+                {
+                    benchmark.prepareFrame(camera, rubiksCube);
+                }
+
+                /* Skip the frame when it would look like the last one */
+                bool changed = !drawn || benchmark.isActive()
+                    || (replaying && (!player.isDone() || scrub != 0.0f))
+                    || rubiksCube.getChangeCount() != drawnCube || camera.getChangeCount() != drawnCamera
+                    || (animated && animator.isAnimating(rubiksCube.getCubes())) || renderer.isAnimating()
+                    || occlusionToggled || occlusion.isConverging() || xRayToggled;
+                idle = !changed;
+                if (idle)
+                {
+                    continue;
+                }
+                /* The shadow map is only redrawn when the cubies may have moved, not for camera moves */
+                if (!drawn || rubiksCube.getChangeCount() != drawnCube || (animated && animator.isAnimating(rubiksCube.getCubes())))
+                {
+                    renderer.markShadowsDirty();
+                    occlusion.restart();
+                }
+                drawn = true;
+                drawnCube = rubiksCube.getChangeCount();
+                drawnCamera = camera.getChangeCount();
+
+                /* Transient data of the last frame is released */
+                FrameArena::getInstance().reset();
+                profiler.beginFrame();
+
+                /* Set white background color */
+                GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+
+                /* Render here */
+                antiAliasing.beginScene(camera.GetWidth(), camera.GetHeight());
+                GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+                /* Draw the cube, between the last two simulation steps */
+                const Cubie* cubes = animated ? animator.getCubes(rubiksCube.getCubes(), scheduler.getAlpha()) : rubiksCube.getCubes();
+                renderer.draw(camera, cubes, scheduler.getFrameTime());
+                occlusion.setCamera(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+                antiAliasing.endScene();
+
+                /* Swap front and back buffers */
+                scheduler.beforeSwap();
+                glfwSwapBuffers(window);
+                scheduler.afterSwap();
+
+                profiler.endFrame();
             }
-            
-            /* Swap front and back buffers */
-            glfwSwapBuffers(window);
 
-            /* Poll for and process events */
-            glfwPollEvents();
+            /* Write the keyframe index of the recording */
+            recorder.stop();
+            scheduler.printReport();
+            renderer.printShadowReport();
+
+            if (benchmark.isActive())
+            {
+                benchmark.report();
+            }
         }
     }
 
     glfwTerminate();
-    return 0;
+    return failed ? -1 : 0;
 }
\ No newline at end of file
@@ -4,17 +4,32 @@
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 color;
 layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec3 normal;
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
+out vec3 v_WorldPosition;
+out vec3 v_Normal;
+out float v_ViewDepth;
+out vec4 v_ShadowCoord;
 
 uniform mat4 u_MVP;
+uniform mat4 u_Model;
+uniform mat4 u_View;
+uniform mat4 u_LightViewProjection;
 
 void main()
 {
 	gl_Position = u_MVP *  vec4(position.x, position.y, position.z, 1.0);
 	v_Color = vec4(color.x, color.y, color.z, 1.0);
 	v_TexCoord = texCoord;
+
+	// Models are scaled uniformly, their rotation part transforms normals as well
+	vec4 world = u_Model * vec4(position, 1.0);
+	v_WorldPosition = world.xyz;
+	v_Normal = mat3(u_Model) * normal;
+	v_ViewDepth = -(u_View * world).z;
+	v_ShadowCoord = u_LightViewProjection * world;
 }
 
 #shader fragment
@@ -24,14 +39,41 @@ layout(location = 0) out vec4 FragColor;
 
 in vec4 v_Color;
 in vec2 v_TexCoord;
+in vec3 v_WorldPosition;
+in vec3 v_Normal;
+in float v_ViewDepth;
+in vec4 v_ShadowCoord;
 
 uniform vec4 u_Color;
 uniform sampler2D u_Texture;
 uniform bool u_picking;
+// Level of detail cross-fade: 0 is opaque, (0, 1) fades in and (-1, 0) fades out with the complementary pattern
+uniform float u_Fade;
+
+const float BAYER[16] = float[16](
+	 0.5 / 16.0,  8.5 / 16.0,  2.5 / 16.0, 10.5 / 16.0,
+	12.5 / 16.0,  4.5 / 16.0, 14.5 / 16.0,  6.5 / 16.0,
+	 3.5 / 16.0, 11.5 / 16.0,  1.5 / 16.0,  9.5 / 16.0,
+	15.5 / 16.0,  7.5 / 16.0, 13.5 / 16.0,  5.5 / 16.0
+);
+
+#include "lighting.glsl"
 
 void main()
 {
+	// Screen-door dithering keeps depth writes valid while two levels overlap
+	ivec2 pixel = ivec2(gl_FragCoord.xy) % 4;
+	float threshold = BAYER[pixel.y * 4 + pixel.x];
+	if (u_Fade > 0.0 && threshold >= u_Fade) discard;
+	if (u_Fade < 0.0 && threshold < -u_Fade) discard;
+
 	vec4 texColor = texture(u_Texture, v_TexCoord) * u_Color;
 	// gl_FragColor = texColor * v_Color;  // Deprecated
-	FragColor = u_picking ? u_Color : texColor * v_Color;
+	if (u_picking)
+	{
+		FragColor = u_Color;
+		return;
+	}
+	vec4 albedo = texColor * v_Color;
+	FragColor = vec4(shade(albedo.rgb, v_WorldPosition, v_Normal, v_ViewDepth, v_ShadowCoord), albedo.a);
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#shader vertex
+#version 330
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// Triangle covering the screen, generated from the vertex index without any vertex buffer
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = corner;
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330
+
+layout(location = 0) out vec4 FragColor;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+uniform vec2 u_InverseSize;
+
+// Contrast below which a pixel isn't considered an edge, relative to the brightest neighbour and absolute
+const float EDGE_THRESHOLD = 1.0 / 8.0;
+const float EDGE_THRESHOLD_MIN = 1.0 / 16.0;
+// Longest blur along an edge, in pixels
+const float SPAN_MAX = 8.0;
+const float REDUCE_MUL = 1.0 / 8.0;
+const float REDUCE_MIN = 1.0 / 128.0;
+
+float luma(vec3 color)
+{
+	return dot(color, vec3(0.299, 0.587, 0.114));
+}
+
+// Fast FXAA: one blur along the edge direction estimated from the diagonal neighbours, no edge end search
+void main()
+{
+	vec3 rgbM = texture(u_Texture, v_TexCoord).rgb;
+	float lumaNW = luma(textureOffset(u_Texture, v_TexCoord, ivec2(-1, 1)).rgb);
+	float lumaNE = luma(textureOffset(u_Texture, v_TexCoord, ivec2(1, 1)).rgb);
+	float lumaSW = luma(textureOffset(u_Texture, v_TexCoord, ivec2(-1, -1)).rgb);
+	float lumaSE = luma(textureOffset(u_Texture, v_TexCoord, ivec2(1, -1)).rgb);
+	float lumaM = luma(rgbM);
+
+	float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+	float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+	if (lumaMax - lumaMin < max(EDGE_THRESHOLD_MIN, lumaMax * EDGE_THRESHOLD))
+	{
+		FragColor = vec4(rgbM, 1.0);
+		return;
+	}
+
+	// Perpendicular to the luma gradient, texture coordinates grow upwards
+	vec2 direction = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)), (lumaNE + lumaSE) - (lumaNW + lumaSW));
+	float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * REDUCE_MUL, REDUCE_MIN);
+	float scale = 1.0 / (min(abs(direction.x), abs(direction.y)) + reduce);
+	direction = clamp(direction * scale, vec2(-SPAN_MAX), vec2(SPAN_MAX)) * u_InverseSize;
+
+	vec3 rgbA = 0.5 * (
+		texture(u_Texture, v_TexCoord + direction * (1.0 / 3.0 - 0.5)).rgb +
+		texture(u_Texture, v_TexCoord + direction * (2.0 / 3.0 - 0.5)).rgb);
+	vec3 rgbB = rgbA * 0.5 + 0.25 * (
+		texture(u_Texture, v_TexCoord - direction * 0.5).rgb +
+		texture(u_Texture, v_TexCoord + direction * 0.5).rgb);
+
+	// The wider blur crossed another edge when it left the local luma range
+	float lumaB = luma(rgbB);
+	FragColor = vec4((lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, 1.0);
+}
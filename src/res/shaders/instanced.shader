@@ -0,0 +1,70 @@
+#shader vertex
+#version 330
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec3 normal;
+// Per-instance Model-View-Projection and Model matrices, one attribute per column
+layout(location = 4) in mat4 instanceMVP;
+layout(location = 8) in mat4 instanceModel;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out vec3 v_WorldPosition;
+out vec3 v_Normal;
+out float v_ViewDepth;
+out vec4 v_ShadowCoord;
+
+uniform mat4 u_View;
+uniform mat4 u_LightViewProjection;
+
+void main()
+{
+	gl_Position = instanceMVP * vec4(position.x, position.y, position.z, 1.0);
+	v_Color = vec4(color.x, color.y, color.z, 1.0);
+	v_TexCoord = texCoord;
+
+	vec4 world = instanceModel * vec4(position, 1.0);
+	v_WorldPosition = world.xyz;
+	v_Normal = mat3(instanceModel) * normal;
+	v_ViewDepth = -(u_View * world).z;
+	v_ShadowCoord = u_LightViewProjection * world;
+}
+
+#shader fragment
+#version 330
+
+layout(location = 0) out vec4 FragColor;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in vec3 v_WorldPosition;
+in vec3 v_Normal;
+in float v_ViewDepth;
+in vec4 v_ShadowCoord;
+
+uniform vec4 u_Color;
+uniform sampler2D u_Texture;
+// Level of detail cross-fade, same dithering as basic.shader
+uniform float u_Fade;
+
+const float BAYER[16] = float[16](
+	 0.5 / 16.0,  8.5 / 16.0,  2.5 / 16.0, 10.5 / 16.0,
+	12.5 / 16.0,  4.5 / 16.0, 14.5 / 16.0,  6.5 / 16.0,
+	 3.5 / 16.0, 11.5 / 16.0,  1.5 / 16.0,  9.5 / 16.0,
+	15.5 / 16.0,  7.5 / 16.0, 13.5 / 16.0,  5.5 / 16.0
+);
+
+#include "lighting.glsl"
+
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy) % 4;
+	float threshold = BAYER[pixel.y * 4 + pixel.x];
+	if (u_Fade > 0.0 && threshold >= u_Fade) discard;
+	if (u_Fade < 0.0 && threshold < -u_Fade) discard;
+
+	vec4 albedo = texture(u_Texture, v_TexCoord) * u_Color * v_Color;
+	FragColor = vec4(shade(albedo.rgb, v_WorldPosition, v_Normal, v_ViewDepth, v_ShadowCoord), albedo.a);
+}
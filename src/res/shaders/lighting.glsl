@@ -0,0 +1,70 @@
+// Forward+ lighting shared by the lit shaders, see Lighting.h
+
+uniform vec3 u_ViewPosition;
+uniform vec3 u_LightDirection;
+uniform vec3 u_LightColor;
+uniform vec3 u_AmbientColor;
+uniform float u_Shininess;
+uniform sampler2DShadow u_ShadowMap;
+
+// Two texels per point light: position and radius, then color
+uniform samplerBuffer u_PointLights;
+// Offset and count of the light indices of every cluster, then the indices
+uniform usamplerBuffer u_Clusters;
+uniform usamplerBuffer u_LightIndices;
+uniform ivec3 u_ClusterGrid;
+// Depth slice of a fragment: log(depth) * x + y
+uniform vec2 u_ClusterDepth;
+uniform vec2 u_ScreenSize;
+
+const float SPECULAR_STRENGTH = 0.5;
+
+// Lit fraction from a 3x3 PCF of the shadow map, each tap filtered 2x2 by the hardware comparison
+float shadowFactor(vec4 shadowCoord)
+{
+	vec3 coord = shadowCoord.xyz / shadowCoord.w * 0.5 + 0.5;
+	vec2 texel = 1.0 / vec2(textureSize(u_ShadowMap, 0));
+	float lit = 0.0;
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+		{
+			lit += texture(u_ShadowMap, vec3(coord.xy + vec2(x, y) * texel, coord.z));
+		}
+	}
+	return lit / 9.0;
+}
+
+vec3 blinnPhong(vec3 albedo, vec3 normal, vec3 toLight, vec3 toView, vec3 radiance)
+{
+	float diffuse = max(dot(normal, toLight), 0.0);
+	float specular = diffuse > 0.0 ? pow(max(dot(normal, normalize(toLight + toView)), 0.0), u_Shininess) : 0.0;
+	return radiance * (albedo * diffuse + vec3(specular * SPECULAR_STRENGTH));
+}
+
+vec3 shade(vec3 albedo, vec3 worldPosition, vec3 normal, float viewDepth, vec4 shadowCoord)
+{
+	normal = normalize(normal);
+	vec3 toView = normalize(u_ViewPosition - worldPosition);
+
+	vec3 color = u_AmbientColor * albedo;
+	color += blinnPhong(albedo, normal, -u_LightDirection, toView, u_LightColor) * shadowFactor(shadowCoord);
+
+	ivec2 tile = clamp(ivec2(gl_FragCoord.xy / u_ScreenSize * vec2(u_ClusterGrid.xy)), ivec2(0), u_ClusterGrid.xy - 1);
+	int slice = clamp(int(log(max(viewDepth, 1e-4)) * u_ClusterDepth.x + u_ClusterDepth.y), 0, u_ClusterGrid.z - 1);
+	uvec2 cluster = texelFetch(u_Clusters, tile.x + u_ClusterGrid.x * (tile.y + u_ClusterGrid.y * slice)).xy;
+	for (uint i = 0u; i < cluster.y; i++)
+	{
+		int light = int(texelFetch(u_LightIndices, int(cluster.x + i)).x);
+		vec4 positionRadius = texelFetch(u_PointLights, 2 * light);
+		vec3 lightColor = texelFetch(u_PointLights, 2 * light + 1).rgb;
+
+		// Inverse square falloff windowed to reach zero at the radius
+		vec3 toLight = positionRadius.xyz - worldPosition;
+		float lightDistance = length(toLight);
+		float window = clamp(1.0 - pow(lightDistance / positionRadius.w, 4.0), 0.0, 1.0);
+		float attenuation = window * window / (lightDistance * lightDistance + 1.0);
+		color += blinnPhong(albedo, normal, toLight / max(lightDistance, 1e-4), toView, lightColor * attenuation);
+	}
+	return color;
+}
@@ -0,0 +1,73 @@
+#shader vertex
+#version 330
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec3 normal;
+// Per-instance Model-View-Projection and Model matrices, one attribute per column
+layout(location = 4) in mat4 instanceMVP;
+layout(location = 8) in mat4 instanceModel;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out vec3 v_WorldPosition;
+out vec3 v_Normal;
+out float v_ViewDepth;
+out vec4 v_ShadowCoord;
+
+uniform mat4 u_View;
+uniform mat4 u_LightViewProjection;
+
+void main()
+{
+	gl_Position = instanceMVP * vec4(position.x, position.y, position.z, 1.0);
+	v_Color = vec4(color.x, color.y, color.z, 1.0);
+	v_TexCoord = texCoord;
+
+	vec4 world = instanceModel * vec4(position, 1.0);
+	v_WorldPosition = world.xyz;
+	v_Normal = mat3(instanceModel) * normal;
+	v_ViewDepth = -(u_View * world).z;
+	v_ShadowCoord = u_LightViewProjection * world;
+}
+
+#shader fragment
+#version 330
+
+// Weighted blended order-independent transparency, see Transparency.h:
+// premultiplied color times the weight with the revealage in alpha, and the sum of the weights
+layout(location = 0) out vec4 FragAccumulation;
+layout(location = 1) out vec4 FragWeight;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in vec3 v_WorldPosition;
+in vec3 v_Normal;
+in float v_ViewDepth;
+in vec4 v_ShadowCoord;
+
+uniform vec4 u_Color;
+uniform sampler2D u_Texture;
+uniform float u_Alpha;
+
+#include "lighting.glsl"
+
+// Closer surfaces weigh more, so the front ones dominate without sorting (McGuire and Bavoil, equation 10)
+float depthWeight(float alpha, float depth)
+{
+	return alpha * clamp(10.0 / (1e-5 + pow(depth / 5.0, 2.0) + pow(depth / 200.0, 6.0)), 1e-2, 3e3);
+}
+
+void main()
+{
+	// Back faces are seen through the front ones, light them from their side
+	vec3 normal = gl_FrontFacing ? v_Normal : -v_Normal;
+	vec4 albedo = texture(u_Texture, v_TexCoord) * u_Color * v_Color;
+	vec3 color = shade(albedo.rgb, v_WorldPosition, normal, v_ViewDepth, v_ShadowCoord);
+
+	float alpha = albedo.a * u_Alpha;
+	float weight = depthWeight(alpha, v_ViewDepth);
+	FragAccumulation = vec4(color * alpha * weight, alpha);
+	FragWeight = vec4(alpha * weight, 0.0, 0.0, alpha);
+}
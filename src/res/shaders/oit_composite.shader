@@ -0,0 +1,30 @@
+#shader vertex
+#version 330
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// Triangle covering the screen, generated from the vertex index without any vertex buffer
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = corner;
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330
+
+layout(location = 0) out vec4 FragColor;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Accumulation;
+uniform sampler2D u_Weights;
+
+// Weighted average of the transparent surfaces, blended over the scene by the product of their transparencies
+void main()
+{
+	vec4 accumulation = texture(u_Accumulation, v_TexCoord);
+	float weights = texture(u_Weights, v_TexCoord).r;
+	FragColor = vec4(accumulation.rgb / max(weights, 1e-5), accumulation.a);
+}
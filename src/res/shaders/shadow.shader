@@ -0,0 +1,21 @@
+#shader vertex
+#version 330
+
+layout(location = 0) in vec3 position;
+// Same per-instance Model matrix as instanced.shader
+layout(location = 8) in mat4 instanceModel;
+
+uniform mat4 u_LightViewProjection;
+
+void main()
+{
+	gl_Position = u_LightViewProjection * instanceModel * vec4(position, 1.0);
+}
+
+#shader fragment
+#version 330
+
+// Depth only
+void main()
+{
+}
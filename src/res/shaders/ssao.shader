@@ -0,0 +1,114 @@
+#shader vertex
+#version 330
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// Triangle covering the screen, generated from the vertex index without any vertex buffer
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = corner;
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330
+
+// Ambient occlusion in r, view depth in g for the depth-aware upsampling and the history rejection.
+// Alpha is 1 so the blending enabled for the scene leaves the result as is
+layout(location = 0) out vec4 FragOcclusion;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Depth;          // full resolution depth of the scene
+uniform sampler2D u_History;        // result of the last frame
+uniform vec2 u_InverseDepthSize;
+
+uniform mat4 u_Projection;
+uniform mat4 u_InverseProjection;
+uniform mat4 u_PreviousProjection;
+uniform mat4 u_ViewToPreviousView;  // from the view space of this frame to the one of the history
+
+uniform float u_Radius;
+uniform float u_HistoryWeight;      // 0 when there is no history
+uniform int u_Frame;
+
+// Few samples per frame, the kernel rotates every frame and the history averages the rotations
+const int SAMPLES = 8;
+const float GOLDEN_ANGLE = 2.39996323;
+// Depth difference below which a sample isn't occluded, keeps flat faces from darkening themselves
+const float BIAS = 0.01;
+// Relative change of the view depth beyond which the history belongs to another surface
+const float HISTORY_DEPTH_TOLERANCE = 0.05;
+
+vec3 viewPosition(vec2 uv, float depth)
+{
+	vec4 position = u_InverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+vec3 viewPositionAt(vec2 uv)
+{
+	return viewPosition(uv, textureLod(u_Depth, uv, 0.0).r);
+}
+
+// Per-pixel noise without a texture, offset every frame for the temporal accumulation
+float interleavedGradientNoise(vec2 pixel)
+{
+	pixel += 5.588238 * float(u_Frame & 63);
+	return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+void main()
+{
+	float depth = textureLod(u_Depth, v_TexCoord, 0.0).r;
+	if (depth >= 1.0)
+	{
+		FragOcclusion = vec4(1.0, 0.0, 0.0, 1.0);
+		return;
+	}
+	vec3 position = viewPosition(v_TexCoord, depth);
+
+	// Normal from the depth, on each axis from the neighbour on the same surface: the other one may be across a gap
+	vec3 left = viewPositionAt(v_TexCoord - vec2(u_InverseDepthSize.x, 0.0));
+	vec3 right = viewPositionAt(v_TexCoord + vec2(u_InverseDepthSize.x, 0.0));
+	vec3 down = viewPositionAt(v_TexCoord - vec2(0.0, u_InverseDepthSize.y));
+	vec3 up = viewPositionAt(v_TexCoord + vec2(0.0, u_InverseDepthSize.y));
+	vec3 dx = abs(right.z - position.z) < abs(position.z - left.z) ? right - position : position - left;
+	vec3 dy = abs(up.z - position.z) < abs(position.z - down.z) ? up - position : position - down;
+	vec3 normal = normalize(cross(dx, dy));
+
+	vec3 tangent = normalize(cross(normal, abs(normal.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0)));
+	vec3 bitangent = cross(normal, tangent);
+
+	// Cosine-weighted hemisphere, denser close to the point where the contact shadows of the gaps are
+	float noise = interleavedGradientNoise(gl_FragCoord.xy);
+	float occlusion = 0.0;
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		float h = (float(i) + noise) / float(SAMPLES);
+		float angle = GOLDEN_ANGLE * float(i) + 6.2831853 * noise;
+		vec3 direction = vec3(sqrt(h) * cos(angle), sqrt(h) * sin(angle), sqrt(1.0 - h));
+		vec3 samplePosition = position + (tangent * direction.x + bitangent * direction.y + normal * direction.z) * u_Radius * mix(0.1, 1.0, h * h);
+
+		vec4 clip = u_Projection * vec4(samplePosition, 1.0);
+		float sceneDepth = viewPositionAt(clip.xy / clip.w * 0.5 + 0.5).z;
+		// Geometry far in front of the point, e.g. another cubie, doesn't occlude it
+		float range = smoothstep(0.0, 1.0, u_Radius / abs(position.z - sceneDepth));
+		occlusion += (sceneDepth >= samplePosition.z + BIAS ? 1.0 : 0.0) * range;
+	}
+	float visibility = 1.0 - occlusion / float(SAMPLES);
+
+	// Blend with where the point was last frame, unless the history there belongs to another surface
+	vec4 previous = u_ViewToPreviousView * vec4(position, 1.0);
+	vec4 previousClip = u_PreviousProjection * previous;
+	vec2 previousUv = previousClip.xy / previousClip.w * 0.5 + 0.5;
+	vec2 history = textureLod(u_History, previousUv, 0.0).rg;
+	float weight = u_HistoryWeight;
+	if (any(lessThan(previousUv, vec2(0.0))) || any(greaterThan(previousUv, vec2(1.0)))
+		|| abs(history.g + previous.z) > HISTORY_DEPTH_TOLERANCE * -previous.z)
+	{
+		weight = 0.0;
+	}
+	FragOcclusion = vec4(mix(visibility, history.r, weight), -position.z, 0.0, 1.0);
+}
@@ -0,0 +1,60 @@
+#shader vertex
+#version 330
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// Triangle covering the screen, generated from the vertex index without any vertex buffer
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = corner;
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330
+
+layout(location = 0) out vec4 FragColor;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;        // resolved scene
+uniform sampler2D u_Depth;
+uniform sampler2D u_Occlusion;      // half resolution, visibility and view depth
+uniform mat4 u_InverseProjection;
+uniform float u_Strength;
+
+// Relative depth difference over which a half resolution texel stops contributing
+const float DEPTH_SHARPNESS = 0.02;
+
+void main()
+{
+	vec3 color = texture(u_Texture, v_TexCoord).rgb;
+	float depth = textureLod(u_Depth, v_TexCoord, 0.0).r;
+	if (depth >= 1.0)
+	{
+		FragColor = vec4(color, 1.0);
+		return;
+	}
+	vec4 position = u_InverseProjection * vec4(vec3(v_TexCoord, depth) * 2.0 - 1.0, 1.0);
+	float viewDepth = -position.z / position.w;
+
+	// Bilateral upsampling: the 4 nearest texels, bilinear weights scaled down when their depth differs
+	ivec2 size = textureSize(u_Occlusion, 0);
+	vec2 texel = v_TexCoord * vec2(size) - 0.5;
+	ivec2 base = ivec2(floor(texel));
+	vec2 f = texel - vec2(base);
+	float visibility = 0.0, total = 0.0;
+	for (int i = 0; i < 4; i++)
+	{
+		ivec2 offset = ivec2(i & 1, i >> 1);
+		vec2 occlusion = texelFetch(u_Occlusion, clamp(base + offset, ivec2(0), size - 1), 0).rg;
+		float bilinear = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+		float weight = bilinear * (exp(-abs(occlusion.g - viewDepth) / (DEPTH_SHARPNESS * viewDepth)) + 1e-3);
+		visibility += occlusion.r * weight;
+		total += weight;
+	}
+	visibility = total > 0.0 ? visibility / total : 1.0;
+
+	FragColor = vec4(color * mix(1.0, visibility, u_Strength), 1.0);
+}
@@ -0,0 +1,138 @@
+#include <Notation.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/*
+Usage: algstats [--threads <n>] <file>
+    --threads  workers sharing the file (default one per core)
+Reads one algorithm per line in WCA notation ('#' starts a comment, "-" reads stdin) and prints, tab separated:
+    line, order, moved pieces (corners c, edges e, centers x), piece cycles, simplified algorithm
+Piece cycles are listed by length for corners then edges, '+' marks cycles that come back twisted or flipped,
+e.g. "c:3 e:2 2" for a corner 3-cycle and two edge swaps.
+*/
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr, "Usage: %s [--threads <n>] <file>\n", program);
+}
+
+// Number of coordinates off the axes: 3 for corners, 2 for edges, 1 for centers
+static int cubieKind(int cubie)
+{
+    return (cubie / 9 != 1) + (cubie / 3 % 3 != 1) + (cubie % 3 != 1);
+}
+
+static std::string analyze(const std::string& line, bool& valid)
+{
+    Algorithm algorithm;
+    std::string error;
+    valid = Algorithm::compile(line, algorithm, &error);
+    if(!valid) { return "error: " + error; }
+
+    const FaceletPermutation& permutation = algorithm.getPermutation();
+    std::vector<PieceCycle> cycles = permutation.pieceCycles();
+    std::sort(cycles.begin(), cycles.end(), [](const PieceCycle& a, const PieceCycle& b) {
+        return a.cubies.size() > b.cubies.size();
+    });
+
+    int moved[4] = {};
+    std::string structure;
+    for(int kind : { 3, 2 }) {
+        std::string lengths;
+        for(const PieceCycle& cycle : cycles) {
+            if(cubieKind(cycle.cubies[0]) != kind) { continue; }
+            lengths += (lengths.empty() ? "" : " ") + std::to_string(cycle.cubies.size()) + (cycle.reoriented ? "+" : "");
+        }
+        if(!lengths.empty()) { structure += (structure.empty() ? "" : " ") + std::string(kind == 3 ? "c:" : "e:") + lengths; }
+    }
+    for(const PieceCycle& cycle : cycles) {
+        moved[cubieKind(cycle.cubies[0])] += (int)cycle.cubies.size();
+    }
+
+    return std::to_string(permutation.order()) + "\t" + std::to_string(moved[3]) + "c " + std::to_string(moved[2]) + "e "
+        + std::to_string(moved[1]) + "x\t" + (structure.empty() ? "-" : structure) + "\t" + algorithm.toString();
+}
+
+int main(int argc, char* argv[])
+{
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    const char* path = nullptr;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = std::max(1, atoi(argv[++i]));
+        } else if(!path) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if(!path) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream file;
+    if(strcmp(path, "-")) {
+        file.open(path);
+        if(!file) {
+            std::fprintf(stderr, "Can't read %s\n", path);
+            return 1;
+        }
+    }
+    std::istream& input = strcmp(path, "-") ? file : std::cin;
+
+    // Algorithms with their line numbers, comments and blank lines dropped
+    std::vector<std::string> lines;
+    std::vector<int> numbers;
+    std::string line;
+    for(int number = 1; std::getline(input, line); number++) {
+        line = line.substr(0, line.find('#'));
+        if(line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+        lines.push_back(line);
+        numbers.push_back(number);
+    }
+
+    int count = (int)lines.size();
+    threads = std::min(threads, std::max(count, 1));
+    std::vector<std::string> results(count);
+    std::vector<int> errors(threads, 0);
+
+    // Contiguous ranges per worker, the output keeps the order of the file
+    auto start = std::chrono::steady_clock::now();
+    auto work = [&](int t) {
+        for(int i = (int)((long long)count * t / threads); i < (int)((long long)count * (t + 1) / threads); i++) {
+            bool valid;
+            results[i] = analyze(lines[i], valid);
+            errors[t] += !valid;
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for(int i = 0; i < count; i++) {
+        std::printf("%d\t%s\n", numbers[i], results[i].c_str());
+    }
+
+    int failed = 0;
+    for(int e : errors) {
+        failed += e;
+    }
+    std::fprintf(stderr, "%d algorithms in %.3fs with %d threads, %d invalid\n", count, seconds, threads, failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+#include <PatternDatabase.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+/*
+Usage: pdbgen [--threads <n>] [--only corners|edges_low|edges_high] <directory>
+    --threads  BFS workers (default one per core)
+    --only     generate a single database
+Writes corners.pdb (42 MB), edges_low.pdb and edges_high.pdb (20 MB each) for the optimal solver.
+Generating needs about 0.9 byte per state, 80 MB for the corners.
+*/
+
+int main(int argc, char* argv[])
+{
+    int threads = 0;
+    int only = -1;
+    std::string directory;
+    for(int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if(!strcmp(argv[i], "--threads") && hasValue) {
+            threads = atoi(argv[++i]);
+        } else if(!strcmp(argv[i], "--only") && hasValue) {
+            std::string name = std::string(argv[++i]) + ".pdb";
+            for(int k = 0; k < PATTERN_KIND_COUNT; k++) {
+                if(name == PatternDatabase::getFileName((PatternKind)k)) { only = k; }
+            }
+            if(only < 0) {
+                std::printf("Unknown database: %s\n", argv[i]);
+                return 1;
+            }
+        } else if(argv[i][0] != '-' && directory.empty()) {
+            directory = argv[i];
+        } else {
+            directory.clear();
+            break;
+        }
+    }
+    if(directory.empty()) {
+        std::printf("Usage: %s [--threads <n>] [--only corners|edges_low|edges_high] <directory>\n", argv[0]);
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    for(int k = 0; k < PATTERN_KIND_COUNT; k++) {
+        if(only >= 0 && k != only) { continue; }
+
+        PatternKind kind = (PatternKind)k;
+        std::string path = directory + "/" + PatternDatabase::getFileName(kind);
+        std::printf("%s: %u states\n", path.c_str(), PatternDatabase::getSize(kind));
+
+        std::vector<uint8_t> table = PatternDatabase::generate(kind, threads, true);
+        if(!PatternDatabase::save(path, kind, table)) {
+            std::printf("Failed to write %s\n", path.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
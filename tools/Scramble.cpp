@@ -0,0 +1,186 @@
+#include <Scrambler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/*
+Usage: scramble [--count <n>] [--seed <s>] [--threads <n>] [--max-length <n>] [--socket <path>]
+    --count       scrambles to print, one per line (default 1)
+    --seed        seed of the random states (default: current time)
+    --threads     workers sharing the batch (default one per core)
+    --max-length  solutions are searched until one is at most this long (default 23)
+    --socket      serve requests on a UNIX socket instead: every line received holds a count (empty for 1),
+                  the reply is that many scrambles, one per line, followed by an empty line
+*/
+
+// Largest count served for one socket request
+static const int MAX_REQUEST_COUNT = 100000;
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr, "Usage: %s [--count <n>] [--seed <s>] [--threads <n>] [--max-length <n>] [--socket <path>]\n", program);
+}
+
+// Split the batch in contiguous ranges with a generator each, so the output only depends on seed and threads
+static int runBatch(int count, uint64_t seed, int threads, int maxLength)
+{
+    std::vector<std::string> scrambles(count);
+    std::vector<double> lengths(threads, 0.0);
+
+    // The solver tables are built by the first generator, before the clock starts
+    std::vector<Scrambler> scramblers;
+    for(int t = 0; t < threads; t++) {
+        scramblers.emplace_back(seed + t, maxLength);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto work = [&](int t) {
+        Scrambler& scrambler = scramblers[t];
+        std::vector<int> moves;
+        for(int i = (int)((long long)count * t / threads); i < (int)((long long)count * (t + 1) / threads); i++) {
+            scrambler.next(moves);
+            scrambles[i] = FormatMoves(moves);
+            lengths[t] += moves.size();
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for(const std::string& scramble : scrambles) {
+        std::puts(scramble.c_str());
+    }
+
+    double length = 0.0;
+    for(double l : lengths) {
+        length += l;
+    }
+    std::fprintf(stderr, "%d scrambles in %.3fs (%.0f/s, %.0f/s per thread), %.2f moves on average\n", count, seconds,
+        count / seconds, count / seconds / threads, length / std::max(count, 1));
+    return 0;
+}
+
+#ifdef _WIN32
+
+static int runServer(const char* path, uint64_t seed, int maxLength)
+{
+    std::fprintf(stderr, "--socket isn't supported on Windows\n");
+    return 1;
+}
+
+#else
+
+static bool sendAll(int connection, const std::string& text)
+{
+    for(size_t sent = 0; sent < text.size();) {
+        ssize_t written = send(connection, text.data() + sent, text.size() - sent, 0);
+        if(written <= 0) { return false; }
+        sent += written;
+    }
+    return true;
+}
+
+// One client at a time, requests of a connection are answered in order
+static int runServer(const char* path, uint64_t seed, int maxLength)
+{
+    // A client closing early must not kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if(server < 0 || std::strlen(path) >= sizeof(address.sun_path)) {
+        std::fprintf(stderr, "Can't create a socket at %s\n", path);
+        return 1;
+    }
+    std::strcpy(address.sun_path, path);
+    unlink(path);
+    if(bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, 16) != 0) {
+        std::fprintf(stderr, "Can't listen on %s\n", path);
+        close(server);
+        return 1;
+    }
+    std::fprintf(stderr, "Serving scrambles on %s\n", path);
+
+    Scrambler scrambler(seed, maxLength);
+    std::vector<int> moves;
+    for(;;) {
+        int connection = accept(server, nullptr, nullptr);
+        if(connection < 0) { continue; }
+
+        std::string pending;
+        char buffer[4096];
+        bool open = true;
+        while(open) {
+            ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+            if(received <= 0) { break; }
+            pending.append(buffer, received);
+
+            size_t end;
+            while(open && (end = pending.find('\n')) != std::string::npos) {
+                int count = end > 0 ? std::atoi(pending.c_str()) : 1;
+                pending.erase(0, end + 1);
+
+                std::string reply;
+                for(int i = 0; i < std::min(std::max(count, 0), MAX_REQUEST_COUNT); i++) {
+                    scrambler.next(moves);
+                    reply += FormatMoves(moves);
+                    reply += '\n';
+                }
+                reply += '\n';
+                open = sendAll(connection, reply);
+            }
+        }
+        close(connection);
+    }
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+    int count = 1;
+    uint64_t seed = (uint64_t)std::time(nullptr);
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int maxLength = SCRAMBLE_MAX_LENGTH;
+    const char* socketPath = nullptr;
+    for(int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if(!strcmp(argv[i], "--count") && hasValue) {
+            count = std::max(0, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--seed") && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if(!strcmp(argv[i], "--threads") && hasValue) {
+            threads = std::max(1, atoi(argv[++i]));
+        } else if(!strcmp(argv[i], "--max-length") && hasValue) {
+            maxLength = atoi(argv[++i]);
+        } else if(!strcmp(argv[i], "--socket") && hasValue) {
+            socketPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(socketPath) { return runServer(socketPath, seed, maxLength); }
+    return runBatch(count, seed, std::min(threads, std::max(count, 1)), maxLength);
+}